@@ -29,7 +29,7 @@ void Ball::create(b2Vec2 position_meters, float radius_meters) {
     bodyDef.isBullet = true; // Enable CCD to prevent clipping
     bodyDef.linearDamping = 0.1f; // Slight damping to prevent excessive sliding
     bodyDef.angularDamping = 0.2f; // Reduce spinning
-    bodyDef.gravityScale = 1.5f; // Make ball more affected by gravity
+    bodyDef.gravityScale = BALL_GRAVITY_SCALE; // Make ball more affected by gravity
 
     bodyId_ = b2CreateBody(worldId_, &bodyDef);
     if (!b2Body_IsValid(bodyId_)) {
@@ -46,41 +46,27 @@ void Ball::create(b2Vec2 position_meters, float radius_meters) {
     fixtureDef.density = 2.0f; // Increased density for better collision
     fixtureDef.material.friction = 0.3f; // Increased friction to reduce sliding
     fixtureDef.material.restitution = 0.01f; // Almost no bounce (was 0.1f)
+    fixtureDef.enableSensorEvents = true; // Holes, goal, warps and reverse items are maze sensors
+    fixtureDef.enableHitEvents = true;    // Reported to Game for adaptive stepping
 
     b2CreateCircleShape(bodyId_, &fixtureDef, &circleShape);
+    savePreviousTransform();
 }
 
-void Ball::render(SDL_Renderer* renderer, float camera_offset_x, float camera_offset_y) const {
+void Ball::render(BatchRenderer& batch, float camera_offset_x, float camera_offset_y, float alpha) const {
     if (!b2Body_IsValid(bodyId_)) return;
 
-    b2Vec2 position_meters = b2Body_GetPosition(bodyId_);
-    b2Rot body_rotation = b2Body_GetRotation(bodyId_);
-    float angle_rad = b2Rot_GetAngle(body_rotation);
+    b2Transform transform = getInterpolatedTransform(alpha);
+    b2Vec2 position_meters = transform.p;
 
     float screen_x = position_meters.x * PPM + camera_offset_x;
     float screen_y = position_meters.y * PPM + camera_offset_y;
     float screen_radius = radiusMeters_ * PPM;
 
-    // Draw a simple circle for the ball
-    SDL_SetRenderDrawColor(renderer, 255, 0, 0, 255); // Red ball
-    const int32_t segments = 20;
-    const float_t increment = 2.0f * M_PI / segments;
-    float_t theta = 0.0f;
-
-    for (int i = 0; i < segments; ++i) {
-        float x1 = screen_radius * cosf(theta) + screen_x;
-        float y1 = screen_radius * sinf(theta) + screen_y;
-        float x2 = screen_radius * cosf(theta + increment) + screen_x;
-        float y2 = screen_radius * sinf(theta + increment) + screen_y;
-        SDL_RenderDrawLine(renderer, static_cast<int>(x1), static_cast<int>(y1), static_cast<int>(x2), static_cast<int>(y2));
-        theta += increment;
-    }
-    
-    // Optional: Draw a line to indicate ball's rotation
-    SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255); // White line
-    float line_end_x = screen_x + screen_radius * cosf(angle_rad);
-    float line_end_y = screen_y + screen_radius * sinf(angle_rad);
-    SDL_RenderDrawLine(renderer, static_cast<int>(screen_x), static_cast<int>(screen_y), static_cast<int>(line_end_x), static_cast<int>(line_end_y));
+    // Red outline, and a white radius to show the ball's rotation
+    batch.strokeCircle(screen_x, screen_y, screen_radius, 1.0f, {255, 0, 0, 255});
+    batch.line(screen_x, screen_y, screen_x + screen_radius * transform.q.c, screen_y + screen_radius * transform.q.s,
+               1.0f, {255, 255, 255, 255});
 }
 
 void Ball::applyForceToCenter(const b2Vec2& force) {
@@ -94,9 +80,39 @@ void Ball::reset(b2Vec2 position_meters) {
         b2Body_SetTransform(bodyId_, position_meters, b2MakeRot(0.0f));
         b2Body_SetLinearVelocity(bodyId_, {0.0f, 0.0f});
         b2Body_SetAngularVelocity(bodyId_, 0.0f);
+        savePreviousTransform(); // Teleported, nothing to blend from
+    }
+}
+
+void Ball::savePreviousTransform() {
+    if (b2Body_IsValid(bodyId_)) {
+        previous_transform_ = b2Body_GetTransform(bodyId_);
+    }
+}
+
+b2Transform Ball::getInterpolatedTransform(float alpha) const {
+    if (!b2Body_IsValid(bodyId_)) {
+        return previous_transform_;
+    }
+    b2Transform current = b2Body_GetTransform(bodyId_);
+    return {b2Lerp(previous_transform_.p, current.p, alpha), b2NLerp(previous_transform_.q, current.q, alpha)};
+}
+
+void Ball::setActive(bool active) {
+    if (!b2Body_IsValid(bodyId_) || active == b2Body_IsEnabled(bodyId_)) {
+        return;
+    }
+    if (active) {
+        b2Body_Enable(bodyId_);
+    } else {
+        b2Body_Disable(bodyId_);
     }
 }
 
+bool Ball::isActive() const {
+    return b2Body_IsValid(bodyId_) && b2Body_IsEnabled(bodyId_);
+}
+
 b2BodyId Ball::getBodyId() const {
     return bodyId_;
 }
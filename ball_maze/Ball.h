@@ -4,6 +4,7 @@
 #include <SDL2/SDL.h>
 #include <box2d/box2d.h>
 #include "constants.h"
+#include "BatchRenderer.h"
 
 class Ball {
 public:
@@ -11,10 +12,20 @@ public:
     ~Ball();
 
     void create(b2Vec2 position_meters, float radius_meters);
-    void render(SDL_Renderer* renderer, float camera_offset_x, float camera_offset_y) const;
+    // alpha blends from the transform before the last physics step (0) to the current one (1)
+    void render(BatchRenderer& batch, float camera_offset_x, float camera_offset_y, float alpha = 1.0f) const;
     void applyForceToCenter(const b2Vec2& force);
     void reset(b2Vec2 position_meters);
 
+    // An inactive ball (one that reached the goal) is taken out of the simulation
+    void setActive(bool active);
+    bool isActive() const;
+
+    // Render interpolation: save the transform before every b2World_Step, and again right
+    // after teleporting the body so the ball isn't drawn sliding across the maze
+    void savePreviousTransform();
+    b2Transform getInterpolatedTransform(float alpha) const;
+
     b2BodyId getBodyId() const;
     b2Vec2 getPosition() const; // In meters
     b2Vec2 getVelocity() const; // In meters/second
@@ -25,6 +36,7 @@ private:
     b2WorldId worldId_;
     b2BodyId bodyId_;
     float radiusMeters_;
+    b2Transform previous_transform_ = b2Transform_identity;
     // SDL_Texture* texture_; // Optional: for sprite-based rendering
 };
 
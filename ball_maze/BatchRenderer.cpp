@@ -0,0 +1,130 @@
+#include "BatchRenderer.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <iostream>
+
+namespace {
+
+// cos/sin of every segment boundary, so a circle costs multiplies instead of trig calls
+struct UnitCircle {
+    std::array<SDL_FPoint, BatchRenderer::CIRCLE_SEGMENTS> points;
+    UnitCircle() {
+        for (int i = 0; i < BatchRenderer::CIRCLE_SEGMENTS; ++i) {
+            float angle = 2.0f * static_cast<float>(M_PI) * i / BatchRenderer::CIRCLE_SEGMENTS;
+            points[i] = {std::cos(angle), std::sin(angle)};
+        }
+    }
+};
+
+const UnitCircle UNIT_CIRCLE;
+
+} // namespace
+
+int BatchRenderer::addVertex(float x, float y, SDL_Color color) {
+    vertices_.push_back({{x, y}, color, {0.0f, 0.0f}});
+    return static_cast<int>(vertices_.size()) - 1;
+}
+
+void BatchRenderer::addTriangle(int a, int b, int c) {
+    indices_.push_back(a);
+    indices_.push_back(b);
+    indices_.push_back(c);
+}
+
+void BatchRenderer::fillCircle(float center_x, float center_y, float radius, SDL_Color color) {
+    int center = addVertex(center_x, center_y, color);
+    for (const SDL_FPoint& point : UNIT_CIRCLE.points) {
+        addVertex(center_x + point.x * radius, center_y + point.y * radius, color);
+    }
+    for (int i = 0; i < CIRCLE_SEGMENTS; ++i) {
+        addTriangle(center, center + 1 + i, center + 1 + (i + 1) % CIRCLE_SEGMENTS);
+    }
+}
+
+void BatchRenderer::strokeCircle(float center_x, float center_y, float radius, float thickness, SDL_Color color) {
+    float inner_radius = std::max(0.0f, radius - thickness);
+    int first = static_cast<int>(vertices_.size());
+    for (const SDL_FPoint& point : UNIT_CIRCLE.points) {
+        addVertex(center_x + point.x * radius, center_y + point.y * radius, color);
+        addVertex(center_x + point.x * inner_radius, center_y + point.y * inner_radius, color);
+    }
+    for (int i = 0; i < CIRCLE_SEGMENTS; ++i) {
+        int outer = first + 2 * i;
+        int next_outer = first + 2 * ((i + 1) % CIRCLE_SEGMENTS);
+        addTriangle(outer, next_outer, outer + 1);
+        addTriangle(outer + 1, next_outer, next_outer + 1);
+    }
+}
+
+void BatchRenderer::fillPie(float center_x, float center_y, float radius, float start_angle, float end_angle, SDL_Color color) {
+    // Partial arcs start and end anywhere, so these few points use trig directly
+    float sweep = end_angle - start_angle;
+    int segments = std::max(1, static_cast<int>(std::ceil(std::fabs(sweep) / (2.0f * M_PI) * CIRCLE_SEGMENTS)));
+    int center = addVertex(center_x, center_y, color);
+    for (int i = 0; i <= segments; ++i) {
+        float angle = start_angle + sweep * i / segments;
+        addVertex(center_x + radius * std::cos(angle), center_y + radius * std::sin(angle), color);
+    }
+    for (int i = 0; i < segments; ++i) {
+        addTriangle(center, center + 1 + i, center + 2 + i);
+    }
+}
+
+void BatchRenderer::line(float x1, float y1, float x2, float y2, float thickness, SDL_Color color) {
+    float dx = x2 - x1;
+    float dy = y2 - y1;
+    float length = std::sqrt(dx * dx + dy * dy);
+    if (length <= 0.0f) {
+        return;
+    }
+    // Offset both ends half the thickness to either side of the line
+    float nx = -dy / length * thickness * 0.5f;
+    float ny = dx / length * thickness * 0.5f;
+    int first = addVertex(x1 + nx, y1 + ny, color);
+    addVertex(x2 + nx, y2 + ny, color);
+    addVertex(x2 - nx, y2 - ny, color);
+    addVertex(x1 - nx, y1 - ny, color);
+    addTriangle(first, first + 1, first + 2);
+    addTriangle(first, first + 2, first + 3);
+}
+
+void BatchRenderer::strokeQuad(const SDL_FPoint corners[4], float thickness, SDL_Color color) {
+    for (int i = 0; i < 4; ++i) {
+        const SDL_FPoint& from = corners[i];
+        const SDL_FPoint& to = corners[(i + 1) % 4];
+        line(from.x, from.y, to.x, to.y, thickness, color);
+    }
+}
+
+void BatchRenderer::fillRect(const SDL_FRect& rect, SDL_Color color) {
+    int first = addVertex(rect.x, rect.y, color);
+    addVertex(rect.x + rect.w, rect.y, color);
+    addVertex(rect.x + rect.w, rect.y + rect.h, color);
+    addVertex(rect.x, rect.y + rect.h, color);
+    addTriangle(first, first + 1, first + 2);
+    addTriangle(first, first + 2, first + 3);
+}
+
+void BatchRenderer::flush(SDL_Renderer* renderer) {
+    if (indices_.empty()) {
+        vertices_.clear();
+        return;
+    }
+
+    // Untextured geometry blends with the draw blend mode; cooldown warps are translucent
+    SDL_BlendMode previous_blend;
+    SDL_GetRenderDrawBlendMode(renderer, &previous_blend);
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+    if (SDL_RenderGeometry(renderer, nullptr, vertices_.data(), static_cast<int>(vertices_.size()),
+                           indices_.data(), static_cast<int>(indices_.size())) != 0) {
+        std::cerr << "Warning: SDL_RenderGeometry failed: " << SDL_GetError() << std::endl;
+    }
+    SDL_SetRenderDrawBlendMode(renderer, previous_blend);
+
+    draw_calls_++;
+    triangles_ += indices_.size() / 3;
+    // clear() keeps the capacity, so after the first frames nothing is allocated
+    vertices_.clear();
+    indices_.clear();
+}
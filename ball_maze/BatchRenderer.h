@@ -0,0 +1,43 @@
+#ifndef BATCH_RENDERER_H
+#define BATCH_RENDERER_H
+
+#include <SDL2/SDL.h>
+#include <vector>
+
+// Immediate-mode batch of untextured triangles. Shapes are added anywhere during a frame and
+// go to the GPU together in one SDL_RenderGeometry call at flush(), instead of one SDL draw
+// call per line, point or scanline. Triangles are drawn in the order they were added, so
+// later shapes still cover earlier ones. Circles use a precomputed unit-circle table.
+class BatchRenderer {
+public:
+    static constexpr int CIRCLE_SEGMENTS = 32;
+
+    void fillCircle(float center_x, float center_y, float radius, SDL_Color color);
+    // Outline with its outer edge at `radius`
+    void strokeCircle(float center_x, float center_y, float radius, float thickness, SDL_Color color);
+    // Filled wedge from start_angle to end_angle (radians, clockwise on screen)
+    void fillPie(float center_x, float center_y, float radius, float start_angle, float end_angle, SDL_Color color);
+    void line(float x1, float y1, float x2, float y2, float thickness, SDL_Color color);
+    // Closed outline through four corners, in order
+    void strokeQuad(const SDL_FPoint corners[4], float thickness, SDL_Color color);
+    void fillRect(const SDL_FRect& rect, SDL_Color color);
+
+    // Draws everything added since the last flush with alpha blending, then empties the batch
+    void flush(SDL_Renderer* renderer);
+
+    // Totals since resetStats(), for benchmarks
+    void resetStats() { draw_calls_ = 0; triangles_ = 0; }
+    int getDrawCalls() const { return draw_calls_; }
+    long long getTriangleCount() const { return triangles_; }
+
+private:
+    int addVertex(float x, float y, SDL_Color color);
+    void addTriangle(int a, int b, int c);
+
+    std::vector<SDL_Vertex> vertices_;
+    std::vector<int> indices_;
+    int draw_calls_ = 0;
+    long long triangles_ = 0;
+};
+
+#endif // BATCH_RENDERER_H
@@ -0,0 +1,89 @@
+#include "Crate.h"
+#include <iostream>
+
+Crate::Crate(b2WorldId worldId) : worldId_(worldId), bodyId_(b2_nullBodyId), start_position_({0.0f, 0.0f}), halfSizeMeters_(0.0f) {
+}
+
+Crate::~Crate() {
+    if (b2Body_IsValid(bodyId_)) {
+        b2DestroyBody(bodyId_);
+        bodyId_ = b2_nullBodyId;
+    }
+}
+
+void Crate::create(b2Vec2 position_meters, float half_size_meters) {
+    if (b2Body_IsValid(bodyId_)) {
+        b2DestroyBody(bodyId_);
+        bodyId_ = b2_nullBodyId;
+    }
+    start_position_ = position_meters;
+    halfSizeMeters_ = half_size_meters;
+
+    b2BodyDef bodyDef = b2DefaultBodyDef();
+    bodyDef.type = b2_dynamicBody;
+    bodyDef.position = position_meters;
+    bodyDef.linearDamping = 0.5f;  // Heavier feel than the ball, crates slide rather than roll
+    bodyDef.angularDamping = 0.5f;
+    bodyDef.gravityScale = BALL_GRAVITY_SCALE; // Same as the ball so they fall together
+    bodyDef.isBullet = true; // The walls are kinematic; only bullets get continuous collision against them
+    bodyId_ = b2CreateBody(worldId_, &bodyDef);
+    if (!b2Body_IsValid(bodyId_)) {
+        std::cerr << "Error: Failed to create crate body!" << std::endl;
+        return;
+    }
+
+    b2Polygon box = b2MakeBox(half_size_meters, half_size_meters);
+    b2ShapeDef shapeDef = b2DefaultShapeDef();
+    shapeDef.density = 1.0f;
+    shapeDef.material.friction = 0.6f;
+    shapeDef.material.restitution = 0.0f;
+    shapeDef.enableSensorEvents = false; // Only balls set off maze sensors
+    shapeDef.enableHitEvents = true; // Impacts keep the physics at full rate, see Game::choosePhysicsStep
+    b2CreatePolygonShape(bodyId_, &shapeDef, &box);
+    savePreviousTransform();
+}
+
+void Crate::render(BatchRenderer& batch, float camera_offset_x, float camera_offset_y, float alpha) const {
+    if (!b2Body_IsValid(bodyId_)) return;
+
+    b2Transform transform = getInterpolatedTransform(alpha);
+    const b2Vec2 local_corners[4] = {
+        {-halfSizeMeters_, -halfSizeMeters_},
+        { halfSizeMeters_, -halfSizeMeters_},
+        { halfSizeMeters_,  halfSizeMeters_},
+        {-halfSizeMeters_,  halfSizeMeters_}
+    };
+
+    SDL_FPoint screen_points[4];
+    for (int i = 0; i < 4; ++i) {
+        b2Vec2 world_corner = b2TransformPoint(transform, local_corners[i]);
+        screen_points[i] = {world_corner.x * PPM + camera_offset_x, world_corner.y * PPM + camera_offset_y};
+    }
+
+    const SDL_Color wood = {181, 130, 70, 255}; // Wooden brown
+    batch.strokeQuad(screen_points, 1.0f, wood);
+    batch.line(screen_points[0].x, screen_points[0].y, screen_points[2].x, screen_points[2].y, 1.0f, wood);
+}
+
+void Crate::reset() {
+    if (b2Body_IsValid(bodyId_)) {
+        b2Body_SetTransform(bodyId_, start_position_, b2MakeRot(0.0f));
+        b2Body_SetLinearVelocity(bodyId_, {0.0f, 0.0f});
+        b2Body_SetAngularVelocity(bodyId_, 0.0f);
+        savePreviousTransform();
+    }
+}
+
+void Crate::savePreviousTransform() {
+    if (b2Body_IsValid(bodyId_)) {
+        previous_transform_ = b2Body_GetTransform(bodyId_);
+    }
+}
+
+b2Transform Crate::getInterpolatedTransform(float alpha) const {
+    if (!b2Body_IsValid(bodyId_)) {
+        return previous_transform_;
+    }
+    b2Transform current = b2Body_GetTransform(bodyId_);
+    return {b2Lerp(previous_transform_.p, current.p, alpha), b2NLerp(previous_transform_.q, current.q, alpha)};
+}
@@ -0,0 +1,38 @@
+#ifndef CRATE_H
+#define CRATE_H
+
+#include <SDL2/SDL.h>
+#include <box2d/box2d.h>
+#include "constants.h"
+#include "BatchRenderer.h"
+
+// A pushable box ('C' in level files). Dynamic body that the balls and the maze walls
+// shove around; it doesn't trigger holes, warps or the goal.
+class Crate {
+public:
+    Crate(b2WorldId worldId);
+    ~Crate();
+
+    void create(b2Vec2 position_meters, float half_size_meters);
+    void render(BatchRenderer& batch, float camera_offset_x, float camera_offset_y, float alpha = 1.0f) const;
+    void reset(); // Back to the spawn position, at rest
+
+    // Render interpolation, see Ball::savePreviousTransform
+    void savePreviousTransform();
+    b2Transform getInterpolatedTransform(float alpha) const;
+
+    b2BodyId getBodyId() const { return bodyId_; }
+    float getHalfSize() const { return halfSizeMeters_; }
+
+private:
+    b2WorldId worldId_;
+    b2BodyId bodyId_;
+    b2Vec2 start_position_;
+    float halfSizeMeters_;
+    b2Transform previous_transform_ = b2Transform_identity;
+
+    Crate(const Crate&) = delete;
+    Crate& operator=(const Crate&) = delete;
+};
+
+#endif // CRATE_H
@@ -0,0 +1,138 @@
+#include "FramePacer.h"
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+void FramePacer::start(SDL_Window* window, bool vsync) {
+    frequency_ = SDL_GetPerformanceFrequency();
+    vsync_ = vsync;
+
+    refresh_rate_ = 0;
+    SDL_DisplayMode mode;
+    int display = window ? SDL_GetWindowDisplayIndex(window) : 0;
+    if (display >= 0 && SDL_GetCurrentDisplayMode(display, &mode) == 0) {
+        refresh_rate_ = mode.refresh_rate;
+    }
+
+    // Under vsync a cap at or above the refresh rate changes nothing, present sets the pace
+    bool cap_paces = fps_cap_ > 0 && (!vsync_ || refresh_rate_ <= 0 || fps_cap_ < refresh_rate_);
+    period_counts_ = cap_paces ? frequency_ / fps_cap_ : 0;
+    if (cap_paces) {
+        expected_period_ms_ = 1000.0 / fps_cap_;
+    } else if (vsync_ && refresh_rate_ > 0) {
+        expected_period_ms_ = 1000.0 / refresh_rate_;
+    } else {
+        expected_period_ms_ = 0.0;
+    }
+
+    std::cout << "Frame pacing: display " << (refresh_rate_ > 0 ? std::to_string(refresh_rate_) + " Hz" : "refresh rate unknown")
+              << ", vsync " << (vsync_ ? "on" : "off") << ", cap "
+              << (fps_cap_ > 0 ? std::to_string(fps_cap_) + " fps" : "none") << std::endl;
+
+    last_frame_ = SDL_GetPerformanceCounter();
+    deadline_ = last_frame_ + period_counts_;
+    snap_carry_ms_ = 0.0;
+    first_frame_ = true;
+    frames_ = 0;
+    interval_sum_ms_ = 0.0;
+    interval_square_sum_ms_ = 0.0;
+    interval_max_ms_ = 0.0;
+    late_frames_ = 0;
+    recent_intervals_ms_.assign(JITTER_HISTORY_FRAMES, 0.0f);
+    next_interval_ = 0;
+}
+
+float FramePacer::beginFrame() {
+    Uint64 now = SDL_GetPerformanceCounter();
+    double interval_ms = countsToMs(now - last_frame_);
+    last_frame_ = now;
+    if (first_frame_) {
+        // Only covers whatever ran between start() and the loop, not a frame
+        first_frame_ = false;
+        return static_cast<float>(interval_ms / 1000.0);
+    }
+
+    frames_++;
+    interval_sum_ms_ += interval_ms;
+    interval_square_sum_ms_ += interval_ms * interval_ms;
+    interval_max_ms_ = std::max(interval_max_ms_, interval_ms);
+    if (expected_period_ms_ > 0.0 && interval_ms > 1.5 * expected_period_ms_) {
+        late_frames_++;
+    }
+    if (!recent_intervals_ms_.empty()) {
+        recent_intervals_ms_[next_interval_] = static_cast<float>(interval_ms);
+        next_interval_ = (next_interval_ + 1) % recent_intervals_ms_.size();
+    }
+
+    double delta_ms = interval_ms;
+    if (expected_period_ms_ > 0.0) {
+        double tolerance_ms = SNAP_TOLERANCE * expected_period_ms_;
+        double carried_ms = interval_ms + snap_carry_ms_;
+        if (std::fabs(carried_ms - expected_period_ms_) < tolerance_ms) {
+            delta_ms = expected_period_ms_;
+            snap_carry_ms_ = carried_ms - expected_period_ms_;
+        } else {
+            delta_ms = carried_ms; // A real hitch: pass it on in full
+            snap_carry_ms_ = 0.0;
+        }
+    }
+    return static_cast<float>(delta_ms / 1000.0);
+}
+
+void FramePacer::waitForNextFrame() {
+    if (period_counts_ == 0) {
+        return;
+    }
+
+    Uint64 now = SDL_GetPerformanceCounter();
+    if (now > deadline_ + period_counts_) {
+        // More than a frame behind (a hitch, a dragged window): start over from now
+        // instead of rushing out the missed frames
+        deadline_ = now + period_counts_;
+        return;
+    }
+
+    if (now < deadline_) {
+        double remaining_ms = countsToMs(deadline_ - now);
+        if (remaining_ms > SPIN_MARGIN_MS) {
+            SDL_Delay(static_cast<Uint32>(remaining_ms - SPIN_MARGIN_MS));
+        }
+        while (SDL_GetPerformanceCounter() < deadline_) {
+            // Spin out the last stretch
+        }
+    }
+    deadline_ += period_counts_;
+}
+
+void FramePacer::printStats() const {
+    if (frames_ < 2) {
+        return;
+    }
+    long long count = frames_;
+    double mean_ms = interval_sum_ms_ / count;
+    double variance = std::max(0.0, interval_square_sum_ms_ / count - mean_ms * mean_ms);
+
+    size_t recent = static_cast<size_t>(std::min<long long>(count, static_cast<long long>(recent_intervals_ms_.size())));
+    std::vector<float> sorted(recent_intervals_ms_.begin(), recent_intervals_ms_.begin() + recent);
+    std::sort(sorted.begin(), sorted.end());
+    auto percentile = [&sorted](double fraction) {
+        return sorted.empty() ? 0.0f : sorted[static_cast<size_t>(fraction * (sorted.size() - 1))];
+    };
+
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "Frame pacing: " << count << " frames";
+    if (expected_period_ms_ > 0.0) {
+        std::cout << ", target " << expected_period_ms_ << " ms";
+    }
+    std::cout << "\n  interval mean " << mean_ms << " ms, jitter (std dev) " << std::sqrt(variance)
+              << " ms, max " << interval_max_ms_ << " ms\n"
+              << "  last " << sorted.size() << " frames: p50 " << percentile(0.50) << " ms, p99 "
+              << percentile(0.99) << " ms, min " << (sorted.empty() ? 0.0f : sorted.front()) << " ms";
+    if (expected_period_ms_ > 0.0) {
+        std::cout << "\n  " << late_frames_ << " frames over 1.5x the target";
+    }
+    std::cout << std::endl;
+    std::cout.unsetf(std::ios_base::floatfield);
+}
@@ -0,0 +1,68 @@
+#ifndef FRAME_PACER_H
+#define FRAME_PACER_H
+
+#include <SDL2/SDL.h>
+#include <vector>
+
+// Paces the game loop on SDL's high-resolution counter. Frames are scheduled against a
+// running deadline (start + n * period) rather than "now + what's left", so a late frame is
+// made up by the next one instead of shifting every frame after it. The wait sleeps with
+// SDL_Delay for most of the time and spins for the last SPIN_MARGIN_MS, since SDL_Delay can
+// oversleep by a millisecond or more.
+//
+// With vsync, SDL_RenderPresent already blocks until the display's next refresh; the pacer
+// then only waits when the cap is below the refresh rate.
+class FramePacer {
+public:
+    static constexpr int DEFAULT_FPS_CAP = 60;
+    static constexpr double SPIN_MARGIN_MS = 2.0;
+    static constexpr int JITTER_HISTORY_FRAMES = 1200; // Intervals kept for the percentiles
+
+    // 0 leaves the frame rate uncapped (or at the refresh rate with vsync)
+    void setFrameRateCap(int fps_cap) { fps_cap_ = fps_cap < 0 ? 0 : fps_cap; }
+    int getFrameRateCap() const { return fps_cap_; }
+
+    // Looks up the refresh rate of the window's display and resets the clock and statistics.
+    // vsync is whether the renderer actually got SDL_RENDERER_PRESENTVSYNC.
+    void start(SDL_Window* window, bool vsync);
+
+    // Seconds since the previous beginFrame(). Within SNAP_TOLERANCE of the frame period the
+    // exact period is returned and the difference carried into a later frame, so the
+    // simulation sees a steady delta instead of timer noise.
+    float beginFrame();
+
+    // Sleeps until the current frame's deadline; returns at once when there is none
+    void waitForNextFrame();
+
+    int getRefreshRate() const { return refresh_rate_; } // 0 if SDL couldn't tell
+    double getTargetFrameMs() const { return expected_period_ms_; } // 0 when nothing sets the pace
+
+    void printStats() const; // Frame interval mean, jitter and outliers to std::cout
+
+private:
+    static constexpr double SNAP_TOLERANCE = 0.02; // Fraction of the period
+
+    double countsToMs(Uint64 counts) const { return counts * 1000.0 / frequency_; }
+
+    Uint64 frequency_ = 1;
+    Uint64 last_frame_ = 0;         // Counter at the last beginFrame()
+    Uint64 deadline_ = 0;           // Counter at which the current frame should end
+    Uint64 period_counts_ = 0;      // Frame length the pacer waits for, 0 when it doesn't wait
+    double expected_period_ms_ = 0.0; // Cap or refresh period, whichever paces the frames
+    int fps_cap_ = DEFAULT_FPS_CAP;
+    int refresh_rate_ = 0;
+    bool vsync_ = false;
+    double snap_carry_ms_ = 0.0;
+    bool first_frame_ = true;
+
+    // Interval statistics since start()
+    long long frames_ = 0;
+    double interval_sum_ms_ = 0.0;
+    double interval_square_sum_ms_ = 0.0;
+    double interval_max_ms_ = 0.0;
+    long long late_frames_ = 0;     // Longer than 1.5 periods
+    std::vector<float> recent_intervals_ms_;
+    size_t next_interval_ = 0;
+};
+
+#endif // FRAME_PACER_H
@@ -1,50 +1,33 @@
 #include "Game.h"
+#include "LevelCache.h"
 #include <SDL2/SDL_ttf.h> // For TTF_Quit
 #include <iostream>
 #include <fstream> // For std::ifstream
 #include <cmath> // For M_PI, b2DistanceSquared
+#include <algorithm> // For std::max, std::remove_if
+#include <cstdio> // For std::snprintf
+#include <ctime>
+#include <mutex>
+#include "MazeGenerator.h"
 
-// Implementation of the circle drawing helper function
-void Game::SDL_RenderDrawCircle(SDL_Renderer* renderer, int center_x, int center_y, int radius) {
-    // Using the midpoint circle algorithm
-    int x = radius;
-    int y = 0;
-    int err = 0;
-    
-    while (x >= y) {
-        SDL_RenderDrawPoint(renderer, center_x + x, center_y + y);
-        SDL_RenderDrawPoint(renderer, center_x + y, center_y + x);
-        SDL_RenderDrawPoint(renderer, center_x - y, center_y + x);
-        SDL_RenderDrawPoint(renderer, center_x - x, center_y + y);
-        SDL_RenderDrawPoint(renderer, center_x - x, center_y - y);
-        SDL_RenderDrawPoint(renderer, center_x - y, center_y - x);
-        SDL_RenderDrawPoint(renderer, center_x + y, center_y - x);
-        SDL_RenderDrawPoint(renderer, center_x + x, center_y - y);
-        
-        if (err <= 0) {
-            y += 1;
-            err += 2*y + 1;
-        }
-        if (err > 0) {
-            x -= 1;
-            err -= 2*x + 1;
-        }
-    }
-}
+// Box2D keeps its worlds in one global table with no locking, so games built on other
+// threads (the level generator validates levels in parallel) take turns creating and
+// destroying them
+static std::mutex world_table_mutex;
 
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
 #endif
 
+static const char* const LEVELS_DIR = "assets/levels";
+
 Game::Game() :
     window_(nullptr),
     renderer_(nullptr),
     is_running_(false),
-    last_tick_(0),
     worldId_(b2_nullWorldId),
     current_level_(nullptr),
     maze_(nullptr),
-    ball_(nullptr),
     maze_world_origin_meters_({0.0f, 0.0f}),
     font_(nullptr),
     title_font_(nullptr)
@@ -61,6 +44,7 @@ bool Game::init() {
         std::cerr << "SDL could not initialize! SDL_Error: " << SDL_GetError() << std::endl;
         return false;
     }
+    sdl_initialized_ = true;
 
     // Initialize SDL_ttf
     if (TTF_Init() < 0) {
@@ -75,11 +59,18 @@ bool Game::init() {
         return false;
     }
 
-    renderer_ = SDL_CreateRenderer(window_, -1, SDL_RENDERER_ACCELERATED);
+    Uint32 renderer_flags = SDL_RENDERER_ACCELERATED | (vsync_requested_ ? SDL_RENDERER_PRESENTVSYNC : 0);
+    renderer_ = SDL_CreateRenderer(window_, -1, renderer_flags);
     if (!renderer_) {
         std::cerr << "Renderer could not be created! SDL_Error: " << SDL_GetError() << std::endl;
         return false;
     }
+    // Some drivers ignore the vsync request; the frame pacer has to know whether to wait
+    SDL_RendererInfo renderer_info;
+    vsync_ = SDL_GetRendererInfo(renderer_, &renderer_info) == 0 && (renderer_info.flags & SDL_RENDERER_PRESENTVSYNC);
+    if (vsync_requested_ && !vsync_) {
+        std::cout << "Vsync not available, pacing with the frame rate cap" << std::endl;
+    }
 
 
 
@@ -96,97 +87,64 @@ bool Game::init() {
         return false;
     }
 
+    if (!createWorld()) {
+        return false;
+    }
+
+    is_running_ = true;
+    return true;
+}
+
+bool Game::initHeadless(bool software_render) {
+    // Only the physics world is needed; SDL video and SDL_ttf stay uninitialized so this
+    // works on machines without a display. The software renderer needs neither.
+    if (software_render) {
+        headless_surface_ = SDL_CreateRGBSurfaceWithFormat(0, SCREEN_WIDTH, SCREEN_HEIGHT, 32, SDL_PIXELFORMAT_RGBA8888);
+        renderer_ = headless_surface_ ? SDL_CreateSoftwareRenderer(headless_surface_) : nullptr;
+        if (!renderer_) {
+            std::cerr << "Software renderer could not be created! SDL_Error: " << SDL_GetError() << std::endl;
+            return false;
+        }
+    }
+
+    if (!createWorld()) {
+        return false;
+    }
+
+    is_running_ = true;
+    return true;
+}
+
+bool Game::createWorld() {
+    bool new_scheduler = !task_scheduler_;
+    if (new_scheduler) {
+        task_scheduler_ = std::make_unique<TaskScheduler>(requested_worker_count_);
+    }
+
     // Initialize Box2D world with increased gravity for faster gameplay
     b2WorldDef worldDef = b2DefaultWorldDef();
-    worldDef.gravity = {0.0f, 20.0f}; // Increased gravity for faster movement
-    worldId_ = b2CreateWorld(&worldDef);
+    worldDef.gravity = {0.0f, WORLD_GRAVITY_Y};
+    task_scheduler_->configureWorld(worldDef);
+    {
+        std::lock_guard<std::mutex> lock(world_table_mutex);
+        worldId_ = b2CreateWorld(&worldDef);
+    }
     if (!b2World_IsValid(worldId_)) {
         std::cerr << "Box2D world could not be created!" << std::endl;
         return false;
     }
 
-    is_running_ = true;
-    last_tick_ = SDL_GetTicks();
+    if (new_scheduler) {
+        std::cout << "Box2D solver using " << task_scheduler_->getWorkerCount() << " worker thread(s)" << std::endl;
+    }
     return true;
 }
 
 void Game::loadLevelPacks() {
-    level_packs_.clear();
     current_level_pack_index_ = 0;
-    
-    // Check if directory exists
-    const std::string levels_dir = "assets/levels";
-    try {
-        // Iterate through all files in the levels directory
-        for (const auto& entry : std::filesystem::directory_iterator(levels_dir)) {
-            if (entry.is_regular_file() && entry.path().extension() == ".txt") {
-                std::string filepath = entry.path().string();
-                
-                // Open the file and read the level pack metadata
-                std::ifstream file(filepath);
-                if (file.is_open()) {
-                    LevelPackInfo pack_info;
-                    pack_info.filepath = filepath;
-                    
-                    // Read only the top metadata section (before any level sections)
-                    bool in_pack_metadata = true;
-                    bool found_empty_line = false;
-                    std::string line;
-                    
-                    while (std::getline(file, line) && in_pack_metadata) {
-                        // Check for empty lines
-                        if (line.empty()) {
-                            // If we've already found pack metadata and now hit an empty line,
-                            // this might be the separator before level sections
-                            if (!pack_info.name.empty()) {
-                                found_empty_line = true;
-                            }
-                            continue;
-                        }
-                        
-                        // If we found an empty line and now a non-empty line, check if it's a new section
-                        if (found_empty_line && line[0] == ';') {
-                            // This is likely the start of a level section
-                            in_pack_metadata = false;
-                            continue;
-                        }
-                        
-                        // Look for metadata in comment lines
-                        if (line[0] == ';') {
-                            std::string metadata = line.substr(1);
-                            // Trim leading whitespace
-                            metadata.erase(0, metadata.find_first_not_of(" \t"));
-                            
-                            if (metadata.find("Name: ") == 0) {
-                                pack_info.name = metadata.substr(6);
-                            } else if (metadata.find("Description: ") == 0) {
-                                pack_info.description = metadata.substr(13);
-                            } else if (metadata.find("Author: ") == 0) {
-                                pack_info.author = metadata.substr(8);
-                            } else if (metadata.find("Date: ") == 0) {
-                                pack_info.date = metadata.substr(6);
-                            }
-                        } else {
-                            // Non-comment line - end of metadata
-                            in_pack_metadata = false;
-                        }
-                    }
-                    
-                    // Add to level packs if we found a name
-                    if (!pack_info.name.empty()) {
-                        level_packs_.push_back(pack_info);
-                        std::cout << "Found level pack: " << pack_info.name << " at " << filepath << std::endl;
-                        std::cout << "  Description: '" << pack_info.description << "'" << std::endl;
-                        std::cout << "  Author: '" << pack_info.author << "'" << std::endl;
-                        std::cout << "  Date: '" << pack_info.date << "'" << std::endl;
-                    }
-                }
-            }
-        }
-    } catch (const std::exception& e) {
-        std::cerr << "Error scanning level packs: " << e.what() << std::endl;
-    }
-    
+
+    // Metadata comes from the compiled pack index; only new or edited packs are re-read
+    level_packs_ = LevelCache::scanLevelPacks(LEVELS_DIR);
     std::cout << "Found " << level_packs_.size() << " level packs" << std::endl;
 }
 
@@ -197,15 +155,67 @@ bool Game::loadSelectedLevelPack() {
     }
     
     const auto& selected_pack = level_packs_[current_level_pack_index_];
+    endless_ = false;
     return loadLevel(selected_pack.filepath);
 }
 
+static LevelData generateEndlessLevel(uint64_t seed, int index) {
+    GeneratorSettings settings;
+    settings.difficulty = std::min(10, 1 + index / Game::ENDLESS_LEVELS_PER_DIFFICULTY);
+
+    LevelData level_data;
+    LevelAnalysis analysis;
+    if (!MazeGenerator(settings).generate(MazeGenerator::levelSeed(seed, index), level_data, analysis)) {
+        std::cerr << "Could not generate endless level " << (index + 1) << std::endl;
+        return LevelData();
+    }
+    level_data.name = "Endless " + std::to_string(index + 1);
+    return level_data;
+}
+
+bool Game::startEndless() {
+    if (endless_seed_ == 0) {
+        endless_seed_ = static_cast<uint64_t>(std::time(nullptr));
+    }
+    std::cout << "Endless mode, seed " << endless_seed_ << std::endl;
+
+    LevelData first = generateEndlessLevel(endless_seed_, 0);
+    auto level = std::make_unique<Level>();
+    if (first.layout.empty() || !level->loadFromLevels("Endless", {first}) || !loadLevel(std::move(level))) {
+        return false;
+    }
+    endless_ = true;
+    prefetchEndlessLevel(1);
+    current_state_ = GameState::LEVEL_INTRO;
+    return true;
+}
+
+void Game::prefetchEndlessLevel(int index) {
+    next_endless_level_ = std::async(std::launch::async, generateEndlessLevel, endless_seed_, index);
+}
+
+bool Game::appendEndlessLevel() {
+    int index = current_level_->getTotalLevels();
+    LevelData next = next_endless_level_.valid() ? next_endless_level_.get() : generateEndlessLevel(endless_seed_, index);
+    if (next.layout.empty()) {
+        return false;
+    }
+    current_level_->appendLevel(std::move(next));
+    prefetchEndlessLevel(index + 1);
+    return true;
+}
+
 bool Game::loadLevel(const std::string& level_filepath) {
-    current_level_ = std::make_unique<Level>();
-    if (!current_level_->loadFromFile(level_filepath)) {
+    auto level = std::make_unique<Level>();
+    if (!level->loadFromFile(level_filepath)) {
         std::cerr << "Failed to load level data from: " << level_filepath << std::endl;
         return false;
     }
+    return loadLevel(std::move(level));
+}
+
+bool Game::loadLevel(std::unique_ptr<Level> level) {
+    current_level_ = std::move(level);
 
     // Define maze origin in world coordinates (e.g., top-left of maze area)
     // Let's place it slightly offset from the screen corner for visibility
@@ -224,36 +234,82 @@ bool Game::loadLevel(const std::string& level_filepath) {
     return true;
 }
 
+bool Game::startLevel(int level_index) {
+    if (!current_level_ || !current_level_->loadLevelByIndex(level_index)) {
+        std::cerr << "Cannot start level " << level_index << ": not available" << std::endl;
+        return false;
+    }
+
+    createMazeAndBall();
+    if (!maze_ || balls_.empty()) {
+        return false;
+    }
+
+    just_started_gameplay_ = false;
+    current_state_ = GameState::GAMEPLAY;
+    return true;
+}
+
+void Game::stepSimulation(int rotation_input) {
+    if (current_state_ != GameState::GAMEPLAY || !maze_) {
+        return;
+    }
+
+    // Same mapping as processGameplayInput, including the reverse item effect
+    applyGameplayInput(rotation_input, false);
+
+    // Zero, one or several b2World_Steps depending on their length, see choosePhysicsStep
+    updateGameplay(TIME_STEP);
+}
+
 void Game::run() {
     // Load level packs at startup
     loadLevelPacks();
+    level_watcher_.start(LEVELS_DIR);
 
-    const int TARGET_FPS = 60;
-    const Uint32 TARGET_FRAME_TIME_MS = 1000 / TARGET_FPS;
-
-    // Initialize last_tick_ properly before the loop for the first delta_time calculation
-    last_tick_ = SDL_GetTicks(); 
+    frame_pacer_.start(window_, vsync_);
 
     while (is_running_) {
-        Uint32 frame_start_time = SDL_GetTicks();
-
-        // Calculate delta_time for the current frame
-        float delta_time = (frame_start_time - last_tick_) / 1000.0f;
-        last_tick_ = frame_start_time; // Update last_tick_ for the next frame
+        // Time since the previous frame, snapped to the frame period when it is within timer noise
+        float delta_time = frame_pacer_.beginFrame();
 
         // Clamp delta_time to prevent large jumps if game pauses/lags (e.g. > 0.05s)
         if (delta_time > 0.05f) {
             delta_time = 0.05f;
         }
 
-        processInput();
-        update(delta_time); // Physics and game logic update
-        render();           // Drawing
+        profiler_.beginFrame();
+        {
+            ScopedTimer timer(profiler_, ProfilePhase::INPUT);
+            processInput();
+            reloadChangedLevelFiles();
+        }
+        {
+            ScopedTimer timer(profiler_, ProfilePhase::UPDATE);
+            update(delta_time); // Physics and game logic update
+        }
+        {
+            ScopedTimer timer(profiler_, ProfilePhase::RENDER);
+            render();       // Drawing
+        }
 
-        Uint32 frame_processing_time = SDL_GetTicks() - frame_start_time;
+        frame_pacer_.waitForNextFrame();
+        profiler_.endFrame(); // The frame's length includes the wait for the frame cap
+    }
+    frame_pacer_.printStats();
+}
 
-        if (frame_processing_time < TARGET_FRAME_TIME_MS) {
-            SDL_Delay(TARGET_FRAME_TIME_MS - frame_processing_time);
+void Game::handleRenderResets() {
+    // Taken out of the queue before any screen polls it, so no state's input loop drops them
+    SDL_PumpEvents();
+    SDL_Event event;
+    while (SDL_PeepEvents(&event, 1, SDL_GETEVENT, SDL_RENDER_TARGETS_RESET, SDL_RENDER_DEVICE_RESET) > 0) {
+        // Render target contents (or all textures) were lost, redraw the cached maze
+        if (maze_) {
+            maze_->buildRenderCache(renderer_);
+        }
+        if (event.type == SDL_RENDER_DEVICE_RESET) {
+            text_cache_.clear();
         }
     }
 }
@@ -263,6 +319,7 @@ static bool left_key_pressed = false;
 static bool right_key_pressed = false;
 
 void Game::processInput() {
+    handleRenderResets();
     switch (current_state_) {
         case GameState::START_SCREEN:
             processStartScreenInput();
@@ -313,17 +370,23 @@ void Game::processStartScreenInput() {
                         }
                     }
                     break;
+
+                case SDLK_e:
+                    startEndless();
+                    break;
             }
         }
     }
 }
 
 void Game::processGameplayInput() {
+    frame_input_.reset = false;
     SDL_Event event;
     while (SDL_PollEvent(&event)) {
         if (event.type == SDL_QUIT) {
             is_running_ = false;
         }
+
         
         if (event.type == SDL_KEYDOWN || event.type == SDL_KEYUP) {
             bool key_pressed = (event.type == SDL_KEYDOWN);
@@ -334,7 +397,8 @@ void Game::processGameplayInput() {
                         // Return to start screen
                         current_state_ = GameState::START_SCREEN;
                         // Clean up gameplay resources
-                        if (ball_) ball_.reset();
+                        balls_.clear();
+                        crates_.clear();
                         if (maze_) maze_.reset();
                         reverse_items_.clear();
                         warps_.clear();
@@ -350,21 +414,20 @@ void Game::processGameplayInput() {
                     break;
                     
                 case SDLK_r:
-                    if (key_pressed && ball_ && current_level_ && maze_) {
-                        b2Vec2 ball_start_grid_pos = current_level_->getBallStartPosition();
-                        float ball_start_x_meters = maze_world_origin_meters_.x + (ball_start_grid_pos.x + 0.5f) * (TILE_SIZE / PPM);
-                        float ball_start_y_meters = maze_world_origin_meters_.y + (ball_start_grid_pos.y + 0.5f) * (TILE_SIZE / PPM);
-                        ball_->reset({ball_start_x_meters, ball_start_y_meters});
-                        maze_->resetRotation();
-                        
-                        // Reset warp positions to their original positions
-                        for (auto& warp : warps_) {
-                            if (warp && b2Body_IsValid(warp->getBodyId())) {
-                                b2Vec2 original_pos = warp->getOriginalPosition();
-                                b2Rot identity_rot = {1.0f, 0.0f}; // Identity rotation (angle = 0)
-                                b2Body_SetTransform(warp->getBodyId(), original_pos, identity_rot);
-                            }
-                        }
+                    if (key_pressed) {
+                        frame_input_.reset = true; // Applied below, after all events are read
+                    }
+                    break;
+
+                case SDLK_F3:
+                    if (key_pressed) {
+                        show_profiler_ = !show_profiler_;
+                    }
+                    break;
+
+                case SDLK_F4:
+                    if (key_pressed) {
+                        exportProfilerTrace();
                     }
                     break;
             }
@@ -373,25 +436,28 @@ void Game::processGameplayInput() {
     
     // Handle continuous rotation based on key states
     if (maze_) {
+        int rotation_input = 0;
         if (just_started_gameplay_) {
             // For the very first frame of gameplay, ensure no rotation command is set,
             // effectively ignoring any held-down rotation keys from the transition.
-            maze_->setRotationDirection(0);
             just_started_gameplay_ = false; // Reset flag for subsequent frames
-        } else {
-            int rotation_direction = 0;
-            if (left_key_pressed && !right_key_pressed) {
-                // Left key: counter-clockwise by default, clockwise if inverted
-                rotation_direction = controls_inverted_ ? 1 : -1;
-            } else if (right_key_pressed && !left_key_pressed) {
-                // Right key: clockwise by default, counter-clockwise if inverted
-                rotation_direction = controls_inverted_ ? -1 : 1;
-            } else {
-                // No keys pressed or both pressed, stop rotation
-                rotation_direction = 0;
-            }
-            maze_->setRotationDirection(rotation_direction);
+        } else if (left_key_pressed && !right_key_pressed) {
+            rotation_input = -1; // Counter-clockwise, clockwise while controls are inverted
+        } else if (right_key_pressed && !left_key_pressed) {
+            rotation_input = 1;
         }
+        // No keys pressed or both pressed stops the rotation
+        frame_input_.rotation_input = rotation_input;
+        applyGameplayInput(rotation_input, frame_input_.reset);
+    }
+}
+
+void Game::applyGameplayInput(int rotation_input, bool reset) {
+    if (reset) {
+        resetBallsToStart();
+    }
+    if (maze_) {
+        maze_->setRotationDirection(controls_inverted_ ? -rotation_input : rotation_input);
     }
 }
 
@@ -407,9 +473,21 @@ void Game::update(float delta_time) {
             updateLevelComplete(delta_time);
             break;
         case GameState::GAMEPLAY:
+            if (replay_writer_) {
+                frame_input_.delta_time = delta_time;
+                replay_writer_->addFrame(frame_input_);
+            }
             updateGameplay(delta_time);
+            if (replay_writer_) {
+                replay_summary_ = {0, physics_step_count_, hashSimulationState(), is_level_won_};
+            }
             break;
     }
+
+    // Won, quit to the menu or lost the level: the recording ends with the last frame played
+    if (replay_writer_ && current_state_ != GameState::GAMEPLAY) {
+        finishRecording();
+    }
 }
 
 void Game::updateStartScreen(float delta_time) {
@@ -437,101 +515,86 @@ void Game::updateGameplay(float delta_time) {
         }
     }
 
-    // Update cooldowns for all reverse items
+    // Update cooldowns for all reverse items and warps
     for (const auto& item : reverse_items_) {
         if (item) {
             item->updateCooldown(delta_time);
         }
     }
+    for (const auto& warp : warps_) {
+        if (warp) {
+            warp->updateCooldown(delta_time);
+        }
+    }
     
-    // Update the maze (handles rotation animation)
+    // Update the maze (handles rotation animation). Warps, items, holes and the goal are
+    // sensors on the maze body, so they rotate with it without any extra work here.
     if (maze_) {
         maze_->update(delta_time);
-        
-        // If the maze is rotating, update warp positions to rotate with the maze
-        if (maze_->isRotating()) {
-            b2Vec2 maze_center = maze_->getMazeCenterWorldCoords();
-            float current_rotation = maze_->getCurrentRotationRad();
-            
-            // Rotate all warp points around the maze center
-            for (auto& warp : warps_) {
-                b2BodyId warp_body = warp->getBodyId();
-                if (b2Body_IsValid(warp_body)) {
-                    // Get the warp's original position relative to maze center
-                    b2Vec2 original_pos = warp->getOriginalPosition();
-                    b2Vec2 relative_pos = b2Sub(original_pos, maze_center);
-                    
-                    // Apply rotation
-                    b2Rot rotation = b2MakeRot(current_rotation);
-                    b2Vec2 rotated_pos = b2Add(maze_center, b2RotateVector(rotation, relative_pos));
-                    
-                    // Update warp position
-                    b2Body_SetTransform(warp_body, rotated_pos, rotation);
-                }
-            }
-        }
     }
     
-    // Check for warp collisions
-    if (ball_) {
-        b2BodyId ball_body = ball_->getBodyId();
-        b2Vec2 ball_pos = b2Body_GetPosition(ball_body);
-        
-        // Check against all warps
-        for (const auto& warp : warps_) {
-            // Skip warps that are on cooldown
-            if (warp->isOnCooldown()) {
-                continue;
-            }
-            
-            b2BodyId warp_body = warp->getBodyId();
-            b2Vec2 warp_pos = b2Body_GetPosition(warp_body);
-            
-            // Simple distance check first
-            b2Vec2 delta = b2Sub(ball_pos, warp_pos);
-            float distance_squared = b2Dot(delta, delta);
-            float min_distance = ball_->getRadius() + warp->getRadius();
-            
-            // Debug output for collision detection
-            if (distance_squared < min_distance * min_distance * 1.5f) {
-                std::cout << "Ball near warp ID " << warp->getId() 
-                          << ", distance: " << sqrt(distance_squared)
-                          << ", threshold: " << min_distance * 0.8f << std::endl;
-            }
-            
-            // For Box2D 3.x, we'll use a simple distance check
-            // If the distance is less than the sum of radii, consider it a collision
-            if (distance_squared < min_distance * min_distance * 0.7f) { // Reduced threshold for more reliable detection
-                std::cout << "Warp collision detected with ID " << warp->getId() << std::endl;
-                Warp::handleWarpCollision(warp->getId(), ball_body, warps_);
-                break; // Only process one warp collision per frame
-            }
-        }
+    // Limit the simulated time per frame to avoid spiral of death
+    const int MAX_PHYSICS_STEPS = 4; // Of TIME_STEP length
+    int quarter_ticks_left = MAX_PHYSICS_STEPS * 4;
+
+    // Everything that collides with the walls keeps the maze chunks around it enabled
+    chunk_probe_bodies_.clear();
+    for (const auto& ball : balls_) {
+        chunk_probe_bodies_.push_back(ball->getBodyId());
+    }
+    for (const auto& crate : crates_) {
+        chunk_probe_bodies_.push_back(crate->getBodyId());
     }
     
-    // Fixed time step for physics, using TIME_STEP from constants.h (1/120s)
-    // time_accumulator_ was already incremented at the start of updateGameplay
-    
-    // Limit the number of steps to avoid spiral of death
-    const int MAX_PHYSICS_STEPS = 4;
-    int steps_taken = 0;
-    
-    // Perform fixed time steps
-    while (time_accumulator_ >= TIME_STEP && steps_taken < MAX_PHYSICS_STEPS) {
+    // Perform steps of the length choosePhysicsStep settles on. When the next step is longer
+    // than what has accumulated, it waits for the next frame instead of shrinking, so steps
+    // stay a whole power-of-two fraction or multiple of TIME_STEP
+    while (quarter_ticks_left > 0) {
+        PhysicsStep step = choosePhysicsStep();
+        float step_seconds = step.quarter_ticks * (TIME_STEP * 0.25f);
+        if (time_accumulator_ < step_seconds || step.quarter_ticks > quarter_ticks_left) {
+            break;
+        }
+
+        // Rendering blends from these transforms to the ones after the last step
+        for (const auto& ball : balls_) {
+            ball->savePreviousTransform();
+        }
+        for (const auto& crate : crates_) {
+            crate->savePreviousTransform();
+        }
+        if (maze_) {
+            maze_->savePreviousTransform();
+            maze_->updateActiveChunks(chunk_probe_bodies_, step_seconds);
+        }
+
         // Step the physics world - Box2D will automatically apply angular velocity to the maze
         // and handle collisions continuously
-        b2World_Step(worldId_, TIME_STEP, POSITION_ITERATIONS); // POSITION_ITERATIONS used as subStepCount
+        {
+            ScopedTimer timer(profiler_, ProfilePhase::PHYSICS);
+            b2World_Step(worldId_, step_seconds, step.sub_steps);
+        }
+        profiler_.addBox2DProfile(b2World_GetProfile(worldId_));
+        physics_step_count_++;
+        sub_step_count_ += step.sub_steps;
+        processSensorEvents(); // Event buffers only hold the step that just ran
+
+        time_since_impact_ += step_seconds;
+        if (b2World_GetContactEvents(worldId_).hitCount > 0) {
+            time_since_impact_ = 0.0f;
+        }
         
-        time_accumulator_ -= TIME_STEP;
-        steps_taken++;
+        time_accumulator_ -= step_seconds;
+        quarter_ticks_left -= step.quarter_ticks;
+        last_step_seconds_ = step_seconds;
     }
 
-    // The global reverse_effect_timer_ (lines 401-407) handles when controls return to normal.
-    // Individual ReverseItem cooldowns are handled by their own updateCooldown methods.
-    // The old logic for resetting all items when the global effect timer ends is removed.
-    
+    // Draw the bodies this far between the last two physics states. It trails the simulation
+    // by up to one step, but motion stays smooth when the display and physics rates differ.
+    render_alpha_ = std::min(time_accumulator_ / last_step_seconds_, 1.0f);
+
     // For large levels, continuously update camera to follow the ball
-    if (current_level_ && ball_) {
+    if (current_level_ && !balls_.empty()) {
         int grid_width = current_level_->getWidth();
         int grid_height = current_level_->getHeight();
         float maze_width_pixels = grid_width * TILE_SIZE;
@@ -542,148 +605,373 @@ void Game::updateGameplay(float delta_time) {
         }
     }
     
-    // Check for collisions with reverse items
-    if (ball_ && maze_) {
-        b2Vec2 ball_pos = ball_->getPosition();
-        float ball_radius = ball_->getRadius();
-        float maze_rotation = maze_->getCurrentRotationRad();
-        b2Vec2 maze_pivot_point = maze_->getMazeCenterWorldCoords();
-        // ball_pos and ball_radius are already defined in this scope if ball_ is valid
-
-        for (const auto& reverse_item : reverse_items_) {
-            if (reverse_item && reverse_item->isActive() && !reverse_item->isCoolingDown()) {
-                // Get the original position of the reverse item
-                b2Vec2 item_pos = reverse_item->getPosition();
-                
-                // Calculate the rotated position based on maze rotation
-                b2Vec2 offset_from_pivot = item_pos - maze_pivot_point;
-                float rotated_offset_x = offset_from_pivot.x * cosf(maze_rotation) - offset_from_pivot.y * sinf(maze_rotation);
-                float rotated_offset_y = offset_from_pivot.x * sinf(maze_rotation) + offset_from_pivot.y * cosf(maze_rotation);
-                b2Vec2 rotated_item_pos = maze_pivot_point + b2Vec2{rotated_offset_x, rotated_offset_y};
-                
-                // Use the rotated position for collision detection
-                // ball_pos and ball_radius are already available from the outer if (ball_ && maze_)
-                float dx = ball_pos.x - rotated_item_pos.x;
-                float dy = ball_pos.y - rotated_item_pos.y;
-                float distance_squared = dx * dx + dy * dy;
-                
-                float item_radius = reverse_item->getRadius(); // Using new method
-                float collision_threshold_sq = (ball_radius + item_radius) * (ball_radius + item_radius);
-
-                if (distance_squared < collision_threshold_sq) {
-                    // Invert controls
-                    controls_inverted_ = true;
-                    reverse_effect_timer_ = REVERSE_EFFECT_DURATION;
-                    
-                    // Start the cooldown for the specific item hit
-                    reverse_item->startCooldown();
-                    
-                    // Visual or audio feedback could be added here
-                    std::cout << "Controls inverted for " << REVERSE_EFFECT_DURATION << " seconds!" << std::endl;
-                }
-            }
+    handleActiveTriggers();
+}
+
+Game::PhysicsStep Game::choosePhysicsStep() const {
+    const PhysicsStep fixed_step = {4, POSITION_ITERATIONS};
+    if (!adaptive_physics_ || !maze_) {
+        return fixed_step;
+    }
+
+    // Fastest motion of a ball or crate relative to the walls. A turning maze moves its walls
+    // at angular velocity times the distance to the pivot, so a body resting against one is
+    // not moving relative to it even though its own velocity isn't zero. The body's far edge
+    // (reach) can still sweep past the wall faster than its center.
+    b2BodyId maze_body = maze_->getBodyId();
+    b2Vec2 pivot = b2Body_GetPosition(maze_body);
+    float maze_angular_velocity = b2Body_GetAngularVelocity(maze_body);
+    float max_speed = 0.0f;
+    float smallest_size = 0.0f; // Ball radius or crate half size, the depth a body can be missed by
+    auto add_body = [&](b2BodyId body_id, float size, float reach) {
+        b2Vec2 position = b2Body_GetPosition(body_id);
+        b2Vec2 wall_velocity = b2CrossSV(maze_angular_velocity, b2Sub(position, pivot));
+        float speed = b2Length(b2Sub(b2Body_GetLinearVelocity(body_id), wall_velocity)) +
+            std::fabs(maze_angular_velocity) * reach;
+        max_speed = std::max(max_speed, speed);
+        smallest_size = smallest_size > 0.0f ? std::min(smallest_size, size) : size;
+    };
+    for (const auto& ball : balls_) {
+        if (ball->isActive()) {
+            add_body(ball->getBodyId(), ball->getRadius(), ball->getRadius());
         }
     }
-    
-    if (steps_taken > 0) { // For debugging
-        //std::cout << "Physics steps taken this frame: " << steps_taken;
-        if (ball_) {
-            // Using PPM to see screen-comparable values, though raw meters are fine too
-            // The line referencing ball_pos has been removed as ball_pos is no longer defined here.
+    for (const auto& crate : crates_) {
+        add_body(crate->getBodyId(), crate->getHalfSize(), crate->getHalfSize() * 1.4142f); // Corner of a turned crate
+    }
+    if (smallest_size <= 0.0f) {
+        return {8, MIN_SUB_STEPS}; // Nothing in play
+    }
+
+    // Distance covered in a step of the given length, with gravity speeding the body up
+    // throughout. The step is halved until no body passes more than a fraction of its size
+    // through a wall between two collision passes, down to a quarter TIME_STEP. Anything
+    // faster than that still doesn't tunnel: balls and crates are bullets, so Box2D's
+    // continuous collision sweeps them against the kinematic wall bodies.
+    const float gravity = WORLD_GRAVITY_Y * BALL_GRAVITY_SCALE;
+    auto travel = [&](int quarter_ticks) {
+        float seconds = quarter_ticks * (TIME_STEP * 0.25f);
+        return (max_speed + gravity * seconds) * seconds;
+    };
+    // Bounces and impacts run at no less than the old fixed rate until they die down
+    bool settling = time_since_impact_ < IMPACT_SETTLE_TIME;
+    PhysicsStep step = {settling ? 4 : 8, POSITION_ITERATIONS};
+    while (step.quarter_ticks > 1 && travel(step.quarter_ticks) > MAX_STEP_TRAVEL_FRACTION * smallest_size) {
+        step.quarter_ticks /= 2;
+    }
+    if (!settling) {
+        int sub_steps = static_cast<int>(std::ceil(travel(step.quarter_ticks) / MAX_SUB_STEP_TRAVEL));
+        step.sub_steps = std::max(MIN_SUB_STEPS, std::min(sub_steps, POSITION_ITERATIONS));
+    }
+    return step;
+}
+
+void Game::processSensorEvents() {
+    if (balls_.empty()) {
+        return;
+    }
+
+    b2SensorEvents sensor_events = b2World_GetSensorEvents(worldId_);
+
+    // Shapes in end events may already be destroyed, so match them by id only
+    for (int i = 0; i < sensor_events.endCount; ++i) {
+        const b2SensorEndTouchEvent& event = sensor_events.endEvents[i];
+        active_sensors_.erase(std::remove_if(active_sensors_.begin(), active_sensors_.end(),
+                                             [&](const SensorContact& contact) {
+                                                 return B2_ID_EQUALS(contact.sensor, event.sensorShapeId) &&
+                                                        B2_ID_EQUALS(contact.ball_shape, event.visitorShapeId);
+                                             }),
+                              active_sensors_.end());
+    }
+
+    for (int i = 0; i < sensor_events.beginCount; ++i) {
+        const b2SensorBeginTouchEvent& event = sensor_events.beginEvents[i];
+        if (!b2Shape_IsValid(event.sensorShapeId) || !b2Shape_IsValid(event.visitorShapeId)) {
+            continue;
         }
-        //std::cout << std::endl;
-    }
-
-    // Check for goal collision
-    if (ball_ && !is_level_won_ && current_level_ && maze_) {
-        const LevelData* level_data = current_level_->getCurrentLevelData();
-        if (level_data) {
-            // Calculate current goal position based on maze rotation
-            b2Vec2 goal_pos_grid = level_data->goal_position;
-            float maze_rotation = maze_->getCurrentRotationRad();
-            b2Vec2 maze_pivot_point = maze_->getMazeCenterWorldCoords();
-
-            b2Vec2 initial_goal_pos_meters = {
-                maze_world_origin_meters_.x + (goal_pos_grid.x + 0.5f) * (TILE_SIZE / PPM),
-                maze_world_origin_meters_.y + (goal_pos_grid.y + 0.5f) * (TILE_SIZE / PPM)
-            };
-
-            b2Vec2 offset_from_pivot = initial_goal_pos_meters - maze_pivot_point;
-            float rotated_offset_x = offset_from_pivot.x * cosf(maze_rotation) - offset_from_pivot.y * sinf(maze_rotation);
-            float rotated_offset_y = offset_from_pivot.x * sinf(maze_rotation) + offset_from_pivot.y * cosf(maze_rotation);
-            b2Vec2 current_goal_pos_meters = maze_pivot_point + b2Vec2{rotated_offset_x, rotated_offset_y};
-            
-            // Now check for collision
-            b2Vec2 ball_pos = ball_->getPosition();
-            float goal_radius_meters = (TILE_SIZE / PPM) * 0.5f;
-            float distance_sq = b2DistanceSquared(ball_pos, current_goal_pos_meters);
-            float total_radius = ball_->getRadius() + goal_radius_meters;
-            float total_radius_sq = total_radius * total_radius;
-
-            if (distance_sq < total_radius_sq) {
-                std::cout << "Congratulations! You completed level " << (current_level_->getCurrentLevelIndex() + 1)
-                          << " of " << current_level_->getTotalLevels() << "!" << std::endl;
-                if (maze_) { // Explicitly stop maze rotation before state change
-                    maze_->setRotationDirection(0);
-                }
-                is_level_won_ = true;
-                current_state_ = GameState::LEVEL_COMPLETE;
-                return; // Exit updateGameplay to show complete screen immediately
-            }
+        // Only balls carry a body userData; crates don't set off sensors
+        int ball_index = static_cast<int>(reinterpret_cast<uintptr_t>(b2Body_GetUserData(b2Shape_GetBody(event.visitorShapeId)))) - 1;
+        if (ball_index < 0 || ball_index >= static_cast<int>(balls_.size())) {
+            continue;
         }
+        active_sensors_.push_back({event.sensorShapeId, event.visitorShapeId, ball_index});
     }
-    // Check hole condition
-    if (ball_ && current_level_ && maze_ && maze_world_origin_meters_.x != 0.0f) { // Check maze_world_origin_meters_ to ensure it's initialized
-        const auto& hole_grid_positions = current_level_->getHolePositions();
-        float hole_radius_meters = (TILE_SIZE / PPM) * 0.45f; // Collision radius for holes (slightly smaller to prevent overlap)
+}
 
-        float maze_rotation = maze_->getCurrentRotationRad(); // Get current maze rotation
-        b2Vec2 maze_pivot_point = maze_->getMazeCenterWorldCoords(); // Get maze pivot
-        
-        for (const auto& grid_pos : hole_grid_positions) {
-            b2Vec2 initial_hole_world_pos = {
-                maze_world_origin_meters_.x + (grid_pos.x + 0.5f) * (TILE_SIZE / PPM),
-                maze_world_origin_meters_.y + (grid_pos.y + 0.5f) * (TILE_SIZE / PPM)
-            };
-            b2Vec2 offset_from_pivot_hole = initial_hole_world_pos - maze_pivot_point;
-            float rotated_offset_x_hole = offset_from_pivot_hole.x * cosf(maze_rotation) - offset_from_pivot_hole.y * sinf(maze_rotation);
-            float rotated_offset_y_hole = offset_from_pivot_hole.x * sinf(maze_rotation) + offset_from_pivot_hole.y * cosf(maze_rotation);
-            b2Vec2 current_hole_center_meters = maze_pivot_point + b2Vec2{rotated_offset_x_hole, rotated_offset_y_hole};
-
-            b2Vec2 ball_pos = ball_->getPosition();
-            float distance_sq = b2DistanceSquared(ball_pos, current_hole_center_meters);
-
-            if (distance_sq < (hole_radius_meters * hole_radius_meters)) {
+void Game::handleActiveTriggers() {
+    if (balls_.empty() || !maze_ || !current_level_ || is_level_won_) {
+        return;
+    }
+
+    // Balls on the goal are taken out of play first; the last one in wins the level
+    std::vector<int> balls_on_goal;
+    for (const SensorContact& contact : active_sensors_) {
+        if (b2Shape_IsValid(contact.sensor) && Trigger::unpack(b2Shape_GetUserData(contact.sensor)).type == TriggerType::GOAL) {
+            balls_on_goal.push_back(contact.ball_index);
+        }
+    }
+    for (int ball_index : balls_on_goal) {
+        deliverBall(ball_index);
+    }
+    if (balls_in_goal_ == static_cast<int>(balls_.size())) {
+        std::cout << "Congratulations! You completed level " << (current_level_->getCurrentLevelIndex() + 1)
+                  << " of " << current_level_->getTotalLevels() << "!" << std::endl;
+        maze_->setRotationDirection(0); // Explicitly stop maze rotation before state change
+        is_level_won_ = true;
+        current_state_ = GameState::LEVEL_COMPLETE;
+        return; // Show complete screen immediately
+    }
+
+    bool warped = false;
+    for (size_t i = 0; i < active_sensors_.size(); ++i) {
+        const SensorContact& contact = active_sensors_[i];
+        if (!b2Shape_IsValid(contact.sensor)) {
+            continue;
+        }
+
+        Ball* ball = balls_[contact.ball_index].get();
+        Trigger trigger = Trigger::unpack(b2Shape_GetUserData(contact.sensor));
+        switch (trigger.type) {
+            case TriggerType::HOLE:
                 std::cout << "Fell into a hole!" << std::endl;
-                
-                b2Vec2 ball_start_grid_pos = current_level_->getBallStartPosition();
-                float ball_start_x_meters = maze_world_origin_meters_.x + (ball_start_grid_pos.x + 0.5f) * (TILE_SIZE / PPM);
-                float ball_start_y_meters = maze_world_origin_meters_.y + (ball_start_grid_pos.y + 0.5f) * (TILE_SIZE / PPM);
-                ball_->reset({ball_start_x_meters, ball_start_y_meters});
-                if (maze_) {
-                    maze_->resetRotation();
-                }
-                
+                resetBallsToStart();
+
                 // Reset reverse controls effect
                 controls_inverted_ = false;
                 reverse_effect_timer_ = 0.0f;
-                // Reverse items are reset by createMazeAndBall() when the level restarts.
-                // No explicit loop needed here as their cooldowns are independent.
-                
-                // Reset warp positions to their original positions
-                for (auto& warp : warps_) {
-                    if (warp && b2Body_IsValid(warp->getBodyId())) {
-                        b2Vec2 original_pos = warp->getOriginalPosition();
-                        b2Rot identity_rot = {1.0f, 0.0f}; // Identity rotation (angle = 0)
-                        b2Body_SetTransform(warp->getBodyId(), original_pos, identity_rot);
+
+                // The ball left the hole; Box2D reports the matching end event on the next step
+                active_sensors_.erase(active_sensors_.begin() + i);
+                std::cout << "Level reset due to falling into a hole." << std::endl;
+                return;
+
+            case TriggerType::WARP:
+                // Only process one warp per frame
+                if (!warped && trigger.index < static_cast<int>(warps_.size())) {
+                    Warp* warp = warps_[trigger.index].get();
+                    if (Warp::handleWarpCollision(warp, ball->getBodyId(), warps_)) {
+                        ball->savePreviousTransform(); // Don't draw the ball sliding to the other warp
+                        time_since_impact_ = 0.0f;
+                        std::cout << "Warp collision detected with ID " << warp->getId() << std::endl;
+                        warped = true;
                     }
                 }
-                
-                std::cout << "Level reset due to falling into a hole." << std::endl;
-                break; 
+                break;
+
+            case TriggerType::REVERSE_ITEM:
+                if (trigger.index < static_cast<int>(reverse_items_.size())) {
+                    ReverseItem* reverse_item = reverse_items_[trigger.index].get();
+                    if (reverse_item->isActive() && !reverse_item->isCoolingDown()) {
+                        // Invert controls
+                        controls_inverted_ = true;
+                        reverse_effect_timer_ = REVERSE_EFFECT_DURATION;
+
+                        // Start the cooldown for the specific item hit
+                        reverse_item->startCooldown();
+                        std::cout << "Controls inverted for " << REVERSE_EFFECT_DURATION << " seconds!" << std::endl;
+                    }
+                }
+                break;
+
+            default:
+                break;
+        }
+    }
+}
+
+void Game::deliverBall(int ball_index) {
+    Ball* ball = balls_[ball_index].get();
+    if (ball->isActive()) {
+        // A disabled body leaves the broad-phase without end events, so drop its contacts here
+        ball->setActive(false);
+        balls_in_goal_++;
+        if (balls_.size() > 1) {
+            std::cout << "Ball in goal (" << balls_in_goal_ << "/" << balls_.size() << ")" << std::endl;
+        }
+    }
+    active_sensors_.erase(std::remove_if(active_sensors_.begin(), active_sensors_.end(),
+                                         [&](const SensorContact& contact) { return contact.ball_index == ball_index; }),
+                          active_sensors_.end());
+}
+
+void Game::resetBallsToStart() {
+    if (balls_.empty() || !current_level_ || !maze_) {
+        return;
+    }
+    const auto& start_positions = current_level_->getBallStartPositions();
+    for (size_t i = 0; i < balls_.size() && i < start_positions.size(); ++i) {
+        balls_[i]->setActive(true);
+        balls_[i]->reset(gridToWorld(start_positions[i]));
+    }
+    for (const auto& crate : crates_) {
+        crate->reset();
+    }
+    balls_in_goal_ = 0;
+    maze_->resetRotation();
+    time_since_impact_ = 0.0f; // Teleported bodies may land against a wall
+}
+
+b2Vec2 Game::gridToWorld(b2Vec2 grid_position) const {
+    return {
+        maze_world_origin_meters_.x + (grid_position.x + 0.5f) * (TILE_SIZE / PPM),
+        maze_world_origin_meters_.y + (grid_position.y + 0.5f) * (TILE_SIZE / PPM)
+    };
+}
+
+void Game::startRecording() {
+    if (!current_level_) {
+        return;
+    }
+    if (current_level_->getFilepath().empty()) {
+        std::cout << "Not recording: generated levels have no pack file to replay from" << std::endl;
+        return;
+    }
+    if (replay_writer_) {
+        finishRecording();
+    }
+
+    // <pack>-level<N>-<date>-<time>.bmr, so a session leaves one file per level played
+    std::time_t now = std::time(nullptr);
+    char timestamp[32];
+    std::strftime(timestamp, sizeof(timestamp), "%Y%m%d-%H%M%S", std::localtime(&now));
+    std::filesystem::path path = std::filesystem::path(record_directory_) /
+        (std::filesystem::path(current_level_->getFilepath()).stem().string() + "-level" +
+         std::to_string(current_level_->getCurrentLevelIndex() + 1) + "-" + timestamp + ".bmr");
+
+    std::error_code error;
+    std::filesystem::create_directories(record_directory_, error);
+    replay_writer_ = std::make_unique<ReplayWriter>();
+    if (!replay_writer_->open(path.string(), current_level_->getFilepath(), current_level_->getCurrentLevelIndex(),
+                              adaptive_physics_)) {
+        replay_writer_.reset();
+        return;
+    }
+    replay_summary_ = {0, 0, hashSimulationState(), false};
+    std::cout << "Recording replay to " << path.string() << std::endl;
+}
+
+void Game::finishRecording() {
+    if (replay_writer_->finish(replay_summary_)) {
+        std::cout << "Saved replay " << replay_writer_->getPath() << " (" << replay_summary_.step_count
+                  << " physics steps)" << std::endl;
+    }
+    replay_writer_.reset();
+}
+
+bool Game::beginReplay(const std::string& replay_path) {
+    replay_reader_ = std::make_unique<ReplayReader>();
+    if (!replay_reader_->open(replay_path)) {
+        replay_reader_.reset();
+        return false;
+    }
+
+    // The same path the live run took: the level is built in a fresh world with no input,
+    // stepped the way the recording was
+    adaptive_physics_ = replay_reader_->isAdaptivePhysics();
+    if (!loadLevel(replay_reader_->getLevelPackPath()) || !startLevel(replay_reader_->getLevelIndex())) {
+        std::cerr << "Error: Could not load level " << (replay_reader_->getLevelIndex() + 1) << " of "
+                  << replay_reader_->getLevelPackPath() << " for the replay" << std::endl;
+        replay_reader_.reset();
+        return false;
+    }
+    maze_->setRotationDirection(0);
+    return true;
+}
+
+bool Game::stepReplay() {
+    ReplayFrame frame;
+    if (!replay_reader_ || current_state_ != GameState::GAMEPLAY || !replay_reader_->nextFrame(frame)) {
+        return false;
+    }
+    applyGameplayInput(frame.rotation_input, frame.reset);
+    updateGameplay(frame.delta_time);
+    return true;
+}
+
+bool Game::finishReplay() {
+    if (!replay_reader_) {
+        return false;
+    }
+    std::unique_ptr<ReplayReader> reader = std::move(replay_reader_);
+    if (!reader->hasSummary()) {
+        std::cout << "Replay finished after " << physics_step_count_ << " physics steps (nothing to compare against)" << std::endl;
+        return false;
+    }
+
+    const ReplaySummary& expected = reader->getSummary();
+    uint64_t state_hash = hashSimulationState();
+    if (physics_step_count_ == expected.step_count && state_hash == expected.state_hash && is_level_won_ == expected.level_won) {
+        std::cout << "Replay matches the recording: " << expected.frame_count << " frames, "
+                  << physics_step_count_ << " physics steps" << std::endl;
+        return true;
+    }
+    std::cout << "Replay DIVERGED from the recording: " << physics_step_count_ << " steps (expected "
+              << expected.step_count << "), state hash " << std::hex << state_hash << " (expected "
+              << expected.state_hash << ")" << std::dec << (is_level_won_ != expected.level_won ? ", different outcome" : "")
+              << std::endl;
+    return false;
+}
+
+bool Game::runReplay(const std::string& replay_path, bool fast_forward) {
+    if (!beginReplay(replay_path)) {
+        return false;
+    }
+
+    // Recorded frames carry their own delta_time, the pacer only decides when to show them
+    frame_pacer_.start(window_, vsync_);
+    double frame_budget_ms = frame_pacer_.getTargetFrameMs() > 0.0 ? frame_pacer_.getTargetFrameMs() : 1000.0 / 60.0;
+    bool playing = true;
+    while (is_running_ && playing) {
+        frame_pacer_.beginFrame();
+        Uint64 frame_start = SDL_GetPerformanceCounter();
+
+        handleRenderResets();
+        SDL_Event event;
+        while (SDL_PollEvent(&event)) {
+            if (event.type == SDL_QUIT || (event.type == SDL_KEYDOWN && event.key.keysym.sym == SDLK_ESCAPE)) {
+                is_running_ = false;
+            } else if (event.type == SDL_KEYDOWN && event.key.keysym.sym == SDLK_TAB) {
+                fast_forward = !fast_forward;
             }
         }
+
+        // Fast-forward simulates recorded frames for a whole display frame and only draws the last
+        do {
+            playing = stepReplay();
+        } while (fast_forward && playing &&
+                 (SDL_GetPerformanceCounter() - frame_start) * 1000.0 / SDL_GetPerformanceFrequency() < frame_budget_ms);
+        render();
+
+        if (!fast_forward) {
+            frame_pacer_.waitForNextFrame();
+        }
+    }
+    frame_pacer_.printStats();
+    return finishReplay();
+}
+
+uint64_t Game::hashSimulationState() const {
+    std::vector<float> state;
+    auto add_body = [&state](b2BodyId body_id) {
+        b2Transform transform = b2Body_GetTransform(body_id);
+        b2Vec2 velocity = b2Body_GetLinearVelocity(body_id);
+        state.insert(state.end(), {transform.p.x, transform.p.y, transform.q.c, transform.q.s,
+                                   velocity.x, velocity.y, b2Body_GetAngularVelocity(body_id)});
+    };
+
+    for (const auto& ball : balls_) {
+        if (ball->isActive()) {
+            add_body(ball->getBodyId());
+        }
+    }
+    for (const auto& crate : crates_) {
+        add_body(crate->getBodyId());
     }
+    if (maze_ && b2Body_IsValid(maze_->getBodyId())) {
+        add_body(maze_->getBodyId());
+    }
+    state.push_back(static_cast<float>(balls_in_goal_));
+    return LevelCache::hashBytes(reinterpret_cast<const unsigned char*>(state.data()), state.size() * sizeof(float));
 }
 
 void Game::render() {
@@ -704,10 +992,93 @@ void Game::render() {
             renderGameplay();
             break;
     }
+    if (show_profiler_) {
+        renderProfilerOverlay();
+    }
     
     SDL_RenderPresent(renderer_);
 }
 
+void Game::renderProfilerOverlay() {
+    const int graph_width = 300; // Half of the recorded frames
+    const int graph_height = 100;
+    SDL_Rect area = {SCREEN_WIDTH - graph_width - 10, SCREEN_HEIGHT - graph_height - 10, graph_width, graph_height};
+    profiler_.renderOverlay(renderer_, area);
+
+    // Averages over the recorded frames. Rounded to 0.1 ms so the text cache isn't
+    // filled with a new texture every frame
+    auto ms = [](float value) {
+        char text[16];
+        std::snprintf(text, sizeof(text), "%.1f", value);
+        return std::string(text);
+    };
+    std::string summary = "frame " + ms(profiler_.getAverageFrameMs()) +
+        " ms  in " + ms(profiler_.getAveragePhaseMs(ProfilePhase::INPUT)) +
+        "  upd " + ms(profiler_.getAveragePhaseMs(ProfilePhase::UPDATE)) +
+        "  phys " + ms(profiler_.getAveragePhaseMs(ProfilePhase::PHYSICS)) +
+        "  draw " + ms(profiler_.getAveragePhaseMs(ProfilePhase::RENDER));
+    int text_width = 0;
+    int text_height = 0;
+    if (font_ && TTF_SizeText(font_, summary.c_str(), &text_width, &text_height) == 0) {
+        renderText(font_, summary, {255, 255, 255, 255}, area.x + area.w - text_width, area.y - text_height - 4);
+    }
+}
+
+void Game::reloadChangedLevelFiles() {
+    for (const std::string& changed_path : level_watcher_.poll()) {
+        if (current_state_ == GameState::START_SCREEN) {
+            // New or renamed packs show up in the list; keep the selection where it was
+            level_packs_ = LevelCache::scanLevelPacks(LEVELS_DIR);
+            if (current_level_pack_index_ >= level_packs_.size()) {
+                current_level_pack_index_ = level_packs_.empty() ? 0 : level_packs_.size() - 1;
+            }
+            continue;
+        }
+
+        std::error_code error;
+        if (!current_level_ || current_level_->getFilepath().empty() ||
+            !std::filesystem::equivalent(changed_path, current_level_->getFilepath(), error)) {
+            continue; // Another pack, or a generated one with no file
+        }
+
+        Uint64 start = SDL_GetPerformanceCounter();
+        auto level = std::make_unique<Level>();
+        if (!level->reloadFromText(current_level_->getFilepath(), current_level_->getCurrentLevelIndex())) {
+            // Often a save caught halfway; the next write triggers another try
+            std::cerr << "Could not reload " << changed_path << ", keeping the loaded version" << std::endl;
+            continue;
+        }
+        current_level_ = std::move(level);
+
+        if (current_state_ == GameState::GAMEPLAY) {
+            // The recording's level no longer matches the file; start a new one on the edit
+            if (replay_writer_) {
+                finishRecording();
+            }
+            float camera_offset_x = camera_offset_x_;
+            float camera_offset_y = camera_offset_y_;
+            createMazeAndBall();
+            camera_offset_x_ = camera_offset_x; // updateCameraOffsets eases in from here
+            camera_offset_y_ = camera_offset_y;
+            if (!record_directory_.empty()) {
+                startRecording();
+            }
+        }
+        // The intro and level complete screens only show the level; it is built on the way in
+
+        double elapsed_ms = (SDL_GetPerformanceCounter() - start) * 1000.0 / SDL_GetPerformanceFrequency();
+        std::cout << "Reloaded level " << (current_level_->getCurrentLevelIndex() + 1) << " of " << changed_path
+                  << " in " << elapsed_ms << " ms" << std::endl;
+    }
+}
+
+void Game::exportProfilerTrace() {
+    std::time_t now = std::time(nullptr);
+    char timestamp[32];
+    std::strftime(timestamp, sizeof(timestamp), "%Y%m%d-%H%M%S", std::localtime(&now));
+    profiler_.exportChromeTrace(std::string("trace-") + timestamp + ".json");
+}
+
 void Game::processLevelIntroInput() {
     SDL_Event e;
     while (SDL_PollEvent(&e) != 0) {
@@ -717,6 +1088,9 @@ void Game::processLevelIntroInput() {
             if (e.key.keysym.sym == SDLK_RETURN) {
                 current_state_ = GameState::GAMEPLAY;
                 createMazeAndBall(); // Create maze & ball for the gameplay session
+                if (!record_directory_.empty()) {
+                    startRecording();
+                }
                 // Reset persistent key states to prevent rotation carry-over
                 left_key_pressed = false;
                 right_key_pressed = false;
@@ -741,7 +1115,8 @@ void Game::processLevelCompleteInput() {
         } else if (e.type == SDL_KEYDOWN) {
             switch (e.key.keysym.sym) {
                 case SDLK_RETURN:
-                    if (current_level_->loadNextLevel()) {
+                    if (current_level_->loadNextLevel() ||
+                        (endless_ && appendEndlessLevel() && current_level_->loadNextLevel())) {
                         // Maze and ball will be created when transitioning from LEVEL_INTRO to GAMEPLAY
                         // Show the intro screen for the new level
                         current_state_ = GameState::LEVEL_INTRO;
@@ -766,26 +1141,10 @@ void Game::renderLevelComplete() {
     SDL_Color white = {255, 255, 255, 255};
 
     // Render "Level Complete!"
-    std::string complete_text = "Level Complete!";
-    SDL_Surface* complete_surface = TTF_RenderText_Blended(title_font_, complete_text.c_str(), white);
-    SDL_Texture* complete_texture = SDL_CreateTextureFromSurface(renderer_, complete_surface);
-    int complete_w = complete_surface->w;
-    int complete_h = complete_surface->h;
-    SDL_Rect complete_rect = {(SCREEN_WIDTH - complete_w) / 2, SCREEN_HEIGHT / 2 - 50, complete_w, complete_h};
-    SDL_RenderCopy(renderer_, complete_texture, nullptr, &complete_rect);
-    SDL_FreeSurface(complete_surface);
-    SDL_DestroyTexture(complete_texture);
+    renderCenteredText(title_font_, "Level Complete!", white, SCREEN_HEIGHT / 2 - 50);
 
     // Render Prompt
-    std::string prompt_text = "Press Enter to Continue";
-    SDL_Surface* prompt_surface = TTF_RenderText_Blended(font_, prompt_text.c_str(), white);
-    SDL_Texture* prompt_texture = SDL_CreateTextureFromSurface(renderer_, prompt_surface);
-    int prompt_w = prompt_surface->w;
-    int prompt_h = prompt_surface->h;
-    SDL_Rect prompt_rect = {(SCREEN_WIDTH - prompt_w) / 2, SCREEN_HEIGHT - 100, prompt_w, prompt_h};
-    SDL_RenderCopy(renderer_, prompt_texture, nullptr, &prompt_rect);
-    SDL_FreeSurface(prompt_surface);
-    SDL_DestroyTexture(prompt_texture);
+    renderCenteredText(font_, "Press Enter to Continue", white, SCREEN_HEIGHT - 100);
 }
 
 void Game::renderLevelIntro() {
@@ -796,50 +1155,18 @@ void Game::renderLevelIntro() {
         if (const LevelData* level_data = current_level_->getCurrentLevelData()) {
         
         // Render Level Name
-        std::string name_text = "Level: " + level_data->name;
-        SDL_Surface* name_surface = TTF_RenderText_Blended(title_font_, name_text.c_str(), white);
-        SDL_Texture* name_texture = SDL_CreateTextureFromSurface(renderer_, name_surface);
-        int name_w = name_surface->w;
-        int name_h = name_surface->h;
-        SDL_Rect name_rect = {(SCREEN_WIDTH - name_w) / 2, 100, name_w, name_h};
-        SDL_RenderCopy(renderer_, name_texture, nullptr, &name_rect);
-        SDL_FreeSurface(name_surface);
-        SDL_DestroyTexture(name_texture);
+        renderCenteredText(title_font_, "Level: " + level_data->name, white, 100);
 
         // Render Description
-        std::string desc_text = "Description: " + level_data->description;
-        SDL_Surface* desc_surface = TTF_RenderText_Blended_Wrapped(font_, desc_text.c_str(), grey, SCREEN_WIDTH - 100);
-        SDL_Texture* desc_texture = SDL_CreateTextureFromSurface(renderer_, desc_surface);
-        int desc_w = desc_surface->w;
-        int desc_h = desc_surface->h;
-        SDL_Rect desc_rect = {(SCREEN_WIDTH - desc_w) / 2, 250, desc_w, desc_h};
-        SDL_RenderCopy(renderer_, desc_texture, nullptr, &desc_rect);
-        SDL_FreeSurface(desc_surface);
-        SDL_DestroyTexture(desc_texture);
+        renderCenteredText(font_, "Description: " + level_data->description, grey, 250, SCREEN_WIDTH - 100);
 
         // Render Difficulty
-        std::string diff_text = "Difficulty: " + level_data->difficulty;
-        SDL_Surface* diff_surface = TTF_RenderText_Blended(font_, diff_text.c_str(), grey);
-        SDL_Texture* diff_texture = SDL_CreateTextureFromSurface(renderer_, diff_surface);
-        int diff_w = diff_surface->w;
-        int diff_h = diff_surface->h;
-        SDL_Rect diff_rect = {(SCREEN_WIDTH - diff_w) / 2, 400, diff_w, diff_h};
-        SDL_RenderCopy(renderer_, diff_texture, nullptr, &diff_rect);
-        SDL_FreeSurface(diff_surface);
-        SDL_DestroyTexture(diff_texture);
+        renderCenteredText(font_, "Difficulty: " + level_data->difficulty, grey, 400);
         }
     }
 
     // Render Prompt
-    std::string prompt_text = "Press Enter to Start";
-    SDL_Surface* prompt_surface = TTF_RenderText_Blended(font_, prompt_text.c_str(), white);
-    SDL_Texture* prompt_texture = SDL_CreateTextureFromSurface(renderer_, prompt_surface);
-    int prompt_w = prompt_surface->w;
-    int prompt_h = prompt_surface->h;
-    SDL_Rect prompt_rect = {(SCREEN_WIDTH - prompt_w) / 2, SCREEN_HEIGHT - 100, prompt_w, prompt_h};
-    SDL_RenderCopy(renderer_, prompt_texture, nullptr, &prompt_rect);
-    SDL_FreeSurface(prompt_surface);
-    SDL_DestroyTexture(prompt_texture);
+    renderCenteredText(font_, "Press Enter to Start", white, SCREEN_HEIGHT - 100);
 }
 
 void Game::renderStartScreen() {
@@ -849,193 +1176,92 @@ void Game::renderStartScreen() {
     
     // Render title
     SDL_Color white = {255, 255, 255, 255};
-    SDL_Surface* title_surface = TTF_RenderText_Blended(title_font_, "Ball Maze Game", white);
-    if (title_surface) {
-        SDL_Texture* title_texture = SDL_CreateTextureFromSurface(renderer_, title_surface);
-        if (title_texture) {
-            SDL_Rect title_rect = {SCREEN_WIDTH / 2 - title_surface->w / 2, 50, title_surface->w, title_surface->h};
-            SDL_RenderCopy(renderer_, title_texture, nullptr, &title_rect);
-            SDL_DestroyTexture(title_texture);
-        }
-        SDL_FreeSurface(title_surface);
-    }
+    renderCenteredText(title_font_, "Ball Maze Game", white, 50);
     
     // Render instructions
-    SDL_Surface* instructions_surface = TTF_RenderText_Blended(font_, "Select a level pack with LEFT/RIGHT arrows. Press ENTER to start.", white);
-    if (instructions_surface) {
-        SDL_Texture* instructions_texture = SDL_CreateTextureFromSurface(renderer_, instructions_surface);
-        if (instructions_texture) {
-            SDL_Rect instructions_rect = {SCREEN_WIDTH / 2 - instructions_surface->w / 2, SCREEN_HEIGHT - 100, instructions_surface->w, instructions_surface->h};
-            SDL_RenderCopy(renderer_, instructions_texture, nullptr, &instructions_rect);
-            SDL_DestroyTexture(instructions_texture);
-        }
-        SDL_FreeSurface(instructions_surface);
-    }
+    renderCenteredText(font_, "Select a level pack with LEFT/RIGHT arrows. Press ENTER to start.", white, SCREEN_HEIGHT - 100);
+    renderCenteredText(font_, "Press E for endless generated levels.", {200, 200, 200, 255}, SCREEN_HEIGHT - 65);
     
     // If no level packs found
     if (level_packs_.empty()) {
-        SDL_Surface* no_levels_surface = TTF_RenderText_Blended(font_, "No level packs found in assets/levels directory", {255, 100, 100, 255});
-        if (no_levels_surface) {
-            SDL_Texture* no_levels_texture = SDL_CreateTextureFromSurface(renderer_, no_levels_surface);
-            if (no_levels_texture) {
-                SDL_Rect no_levels_rect = {SCREEN_WIDTH / 2 - no_levels_surface->w / 2, SCREEN_HEIGHT / 2, no_levels_surface->w, no_levels_surface->h};
-                SDL_RenderCopy(renderer_, no_levels_texture, nullptr, &no_levels_rect);
-                SDL_DestroyTexture(no_levels_texture);
-            }
-            SDL_FreeSurface(no_levels_surface);
-        }
+        renderCenteredText(font_, "No level packs found in assets/levels directory", {255, 100, 100, 255}, SCREEN_HEIGHT / 2);
     } else {
         // Render level pack info
         const auto& pack = level_packs_[current_level_pack_index_];
         
         // Render level pack name
-        SDL_Surface* name_surface = TTF_RenderText_Blended(title_font_, pack.name.c_str(), {255, 255, 150, 255});
-        if (name_surface) {
-            SDL_Texture* name_texture = SDL_CreateTextureFromSurface(renderer_, name_surface);
-            if (name_texture) {
-                SDL_Rect name_rect = {SCREEN_WIDTH / 2 - name_surface->w / 2, SCREEN_HEIGHT / 2 - 100, name_surface->w, name_surface->h};
-                SDL_RenderCopy(renderer_, name_texture, nullptr, &name_rect);
-                SDL_DestroyTexture(name_texture);
-            }
-            SDL_FreeSurface(name_surface);
-        }
+        renderCenteredText(title_font_, pack.name, {255, 255, 150, 255}, SCREEN_HEIGHT / 2 - 100);
         
         // Render level pack description
-        SDL_Surface* desc_surface = TTF_RenderText_Blended(font_, pack.description.c_str(), white);
-        if (desc_surface) {
-            SDL_Texture* desc_texture = SDL_CreateTextureFromSurface(renderer_, desc_surface);
-            if (desc_texture) {
-                SDL_Rect desc_rect = {SCREEN_WIDTH / 2 - desc_surface->w / 2, SCREEN_HEIGHT / 2 - 40, desc_surface->w, desc_surface->h};
-                SDL_RenderCopy(renderer_, desc_texture, nullptr, &desc_rect);
-                SDL_DestroyTexture(desc_texture);
-            }
-            SDL_FreeSurface(desc_surface);
-        }
+        renderCenteredText(font_, pack.description, white, SCREEN_HEIGHT / 2 - 40);
         
         // Render author
-        std::string author_text = "By: " + pack.author;
-        SDL_Surface* author_surface = TTF_RenderText_Blended(font_, author_text.c_str(), {200, 200, 200, 255});
-        if (author_surface) {
-            SDL_Texture* author_texture = SDL_CreateTextureFromSurface(renderer_, author_surface);
-            if (author_texture) {
-                SDL_Rect author_rect = {SCREEN_WIDTH / 2 - author_surface->w / 2, SCREEN_HEIGHT / 2 + 20, author_surface->w, author_surface->h};
-                SDL_RenderCopy(renderer_, author_texture, nullptr, &author_rect);
-                SDL_DestroyTexture(author_texture);
-            }
-            SDL_FreeSurface(author_surface);
-        }
+        renderCenteredText(font_, "By: " + pack.author, {200, 200, 200, 255}, SCREEN_HEIGHT / 2 + 20);
+    }
+}
+
+void Game::renderText(TTF_Font* font, const std::string& text, SDL_Color color, int x, int y) {
+    if (const TextTexture* text_texture = text_cache_.get(renderer_, font, text, color)) {
+        SDL_Rect dstrect = {x, y, text_texture->width, text_texture->height};
+        SDL_RenderCopy(renderer_, text_texture->texture, nullptr, &dstrect);
+    }
+}
+
+void Game::renderCenteredText(TTF_Font* font, const std::string& text, SDL_Color color, int y, int wrap_width) {
+    if (const TextTexture* text_texture = text_cache_.get(renderer_, font, text, color, wrap_width)) {
+        SDL_Rect dstrect = {(SCREEN_WIDTH - text_texture->width) / 2, y, text_texture->width, text_texture->height};
+        SDL_RenderCopy(renderer_, text_texture->texture, nullptr, &dstrect);
     }
 }
 
 void Game::renderGameplay() {
     updateCameraOffsets();
 
-    // Render the maze
+    // Render the maze (walls, holes and goal)
     if (maze_) {
-        maze_->render(renderer_, camera_offset_x_, camera_offset_y_);
+        maze_->render(renderer_, batch_, camera_offset_x_, camera_offset_y_, render_alpha_);
     }
 
-    // Render the ball
-    if (ball_) {
-        ball_->render(renderer_, camera_offset_x_, camera_offset_y_);
-    }
+    // Crates and balls move freely, so they are checked one by one against the screen
+    auto on_screen = [&](b2Vec2 world_position, float radius_meters) {
+        float x = world_position.x * PPM + camera_offset_x_;
+        float y = world_position.y * PPM + camera_offset_y_;
+        float radius = radius_meters * PPM;
+        return x + radius >= 0.0f && x - radius <= SCREEN_WIDTH && y + radius >= 0.0f && y - radius <= SCREEN_HEIGHT;
+    };
 
-    // Render the goal
-    if (current_level_ && maze_) {
-        if (const LevelData* level_data = current_level_->getCurrentLevelData()) {
-            b2Vec2 goal_pos_grid = level_data->goal_position;
-            float maze_rotation = maze_->getCurrentRotationRad();
-            b2Vec2 maze_pivot_point = maze_->getMazeCenterWorldCoords();
-
-            b2Vec2 initial_goal_pos_meters = {
-                maze_world_origin_meters_.x + (goal_pos_grid.x + 0.5f) * (TILE_SIZE / PPM),
-                maze_world_origin_meters_.y + (goal_pos_grid.y + 0.5f) * (TILE_SIZE / PPM)
-            };
-
-            b2Vec2 offset_from_pivot = initial_goal_pos_meters - maze_pivot_point;
-            float rotated_offset_x = offset_from_pivot.x * cosf(maze_rotation) - offset_from_pivot.y * sinf(maze_rotation);
-            float rotated_offset_y = offset_from_pivot.x * sinf(maze_rotation) + offset_from_pivot.y * cosf(maze_rotation);
-            b2Vec2 current_goal_pos_meters = maze_pivot_point + b2Vec2{rotated_offset_x, rotated_offset_y};
-
-            int screen_x = static_cast<int>(current_goal_pos_meters.x * PPM + camera_offset_x_);
-            int screen_y = static_cast<int>(current_goal_pos_meters.y * PPM + camera_offset_y_);
-            int tile_size_pixels = TILE_SIZE;
-
-            int radius = tile_size_pixels / 2;
-            SDL_SetRenderDrawColor(renderer_, 0, 255, 0, 255); // Green for the goal
-
-            // Draw a filled circle by drawing horizontal lines
-            for (int dy = -radius; dy <= radius; ++dy) {
-                int dx = static_cast<int>(sqrt((radius * radius) - (dy * dy)));
-                SDL_RenderDrawLine(renderer_, screen_x - dx, screen_y + dy, screen_x + dx, screen_y + dy);
-            }
+    // Render the crates and the balls still in play
+    const float tile_meters = TILE_SIZE / PPM;
+    for (const auto& crate : crates_) {
+        if (on_screen(crate->getInterpolatedTransform(render_alpha_).p, tile_meters)) { // Wider than any crate
+            crate->render(batch_, camera_offset_x_, camera_offset_y_, render_alpha_);
         }
     }
-
-    // Render warps
-    for (const auto& warp : warps_) {
-        if (warp) {
-            warp->render(renderer_, camera_offset_x_, camera_offset_y_);
+    for (const auto& ball : balls_) {
+        if (ball->isActive() && on_screen(ball->getInterpolatedTransform(render_alpha_).p, ball->getRadius())) {
+            ball->render(batch_, camera_offset_x_, camera_offset_y_, render_alpha_);
         }
     }
 
-    // Render reverse items
-    if (maze_) { // Ensure maze_ is valid for rotation calculations
-        float maze_rotation_render = maze_->getCurrentRotationRad();
-        b2Vec2 maze_pivot_point_render = maze_->getMazeCenterWorldCoords();
-
-        for (const auto& reverse_item : reverse_items_) {
-            if (reverse_item && reverse_item->isActive()) { // Render if active, cooldown state is handled by item's render method
-                b2Vec2 item_original_pos = reverse_item->getPosition();
-                
-                // Calculate the rotated position for rendering
-                b2Vec2 offset_from_pivot_render = item_original_pos - maze_pivot_point_render;
-                float rotated_offset_x_render = offset_from_pivot_render.x * cosf(maze_rotation_render) - offset_from_pivot_render.y * sinf(maze_rotation_render);
-                float rotated_offset_y_render = offset_from_pivot_render.x * sinf(maze_rotation_render) + offset_from_pivot_render.y * cosf(maze_rotation_render);
-                b2Vec2 rotated_item_render_pos = maze_pivot_point_render + b2Vec2{rotated_offset_x_render, rotated_offset_y_render};
-                
-                reverse_item->render(renderer_, camera_offset_x_, camera_offset_y_, rotated_item_render_pos);
-            }
-        }
-    } else { // Fallback if maze_ is null, render items at their original positions
-        for (const auto& reverse_item : reverse_items_) {
-            if (reverse_item && reverse_item->isActive()) {
-                reverse_item->render(renderer_, camera_offset_x_, camera_offset_y_); // Pass default rotated_position
-            }
-        }
+    // Warps and reverse items sit on the maze, so place them with the same blended transform
+    if (!maze_) {
+        batch_.flush(renderer_);
+        return;
     }
-
-    // Render holes
-    if (current_level_ && maze_) {
-        const auto& hole_grid_positions = current_level_->getHolePositions();
-        float hole_radius_pixels = (TILE_SIZE / 2.0f) * 0.9f; // 90% of half tile size
-
-        float maze_rotation = maze_->getCurrentRotationRad();
-        b2Vec2 maze_pivot_point = maze_->getMazeCenterWorldCoords();
-
-        SDL_SetRenderDrawColor(renderer_, 0, 0, 0, 255); // Black color for holes
-
-        for (const auto& grid_pos : hole_grid_positions) {
-            b2Vec2 initial_hole_world_pos = {
-                maze_world_origin_meters_.x + (grid_pos.x + 0.5f) * (TILE_SIZE / PPM),
-                maze_world_origin_meters_.y + (grid_pos.y + 0.5f) * (TILE_SIZE / PPM)
-            };
-
-            b2Vec2 offset_from_pivot = initial_hole_world_pos - maze_pivot_point;
-            float rotated_offset_x = offset_from_pivot.x * cosf(maze_rotation) - offset_from_pivot.y * sinf(maze_rotation);
-            float rotated_offset_y = offset_from_pivot.x * sinf(maze_rotation) + offset_from_pivot.y * cosf(maze_rotation);
-            b2Vec2 current_hole_pos_meters = maze_pivot_point + b2Vec2{rotated_offset_x, rotated_offset_y};
-
-            int screen_x = static_cast<int>(current_hole_pos_meters.x * PPM + camera_offset_x_);
-            int screen_y = static_cast<int>(current_hole_pos_meters.y * PPM + camera_offset_y_);
-
-            // Draw a filled circle by drawing horizontal lines
-            for (int dy = -hole_radius_pixels; dy <= hole_radius_pixels; ++dy) {
-                int dx = static_cast<int>(sqrt((hole_radius_pixels * hole_radius_pixels) - (dy * dy)));
-                SDL_RenderDrawLine(renderer_, screen_x - dx, screen_y + dy, screen_x + dx, screen_y + dy);
-            }
+    b2Transform maze_transform = maze_->getInterpolatedTransform(render_alpha_);
+    maze_item_grid_.query(maze_->getVisibleLocalBounds(maze_transform, camera_offset_x_, camera_offset_y_), visible_items_);
+    for (int item : visible_items_) {
+        if (item < static_cast<int>(warps_.size())) {
+            warps_[item]->render(batch_, maze_transform, camera_offset_x_, camera_offset_y_);
+            continue;
+        }
+        // Cooldown state is handled by the item's render method
+        const auto& reverse_item = reverse_items_[item - warps_.size()];
+        if (reverse_item->isActive()) {
+            reverse_item->render(batch_, maze_transform, camera_offset_x_, camera_offset_y_);
         }
     }
+    batch_.flush(renderer_); // Everything above in one SDL_RenderGeometry call, under the text
 
     // Render status messages (e.g., warp cooldown, reverse effect duration)
     SDL_Color white = {255, 255, 255, 255};
@@ -1051,16 +1277,7 @@ void Game::renderGameplay() {
     // }
 
     if (!status_text.empty()) {
-        SDL_Surface* surface = TTF_RenderText_Blended(font_, status_text.c_str(), white);
-        if (surface) {
-            SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer_, surface);
-            if (texture) {
-                SDL_Rect dstrect = {10, 10, surface->w, surface->h};
-                SDL_RenderCopy(renderer_, texture, nullptr, &dstrect);
-                SDL_DestroyTexture(texture);
-            }
-            SDL_FreeSurface(surface);
-        }
+        renderText(font_, status_text, white, 10, 10);
     }
 } // Correct closing brace for renderGameplay
 
@@ -1073,11 +1290,31 @@ void Game::createMazeAndBall() {
 
     // 1. Complete Cleanup of the previous level
     if (maze_) maze_.reset();
-    if (ball_) ball_.reset();
+    balls_.clear();
+    crates_.clear();
+    balls_in_goal_ = 0;
     reverse_items_.clear();
     warps_.clear();
+    active_sensors_.clear();
+
+    // A fresh world for every run. Box2D gives identical results for an identical world fed
+    // identical input, which replays depend on; a reused world carries over ids and caches.
+    if (b2World_IsValid(worldId_)) {
+        std::lock_guard<std::mutex> lock(world_table_mutex);
+        b2DestroyWorld(worldId_);
+        worldId_ = b2_nullWorldId;
+    }
+    if (!createWorld()) {
+        return;
+    }
 
     // 2. Reset all level-specific states and timers
+    time_accumulator_ = 0.0f; // Start every run on a step boundary so it is reproducible
+    render_alpha_ = 1.0f;
+    physics_step_count_ = 0;
+    sub_step_count_ = 0;
+    time_since_impact_ = 0.0f; // Balls and crates settle onto the floor at the full rate
+    last_step_seconds_ = TIME_STEP;
     is_level_won_ = false;
     controls_inverted_ = false;
     reverse_effect_timer_ = 0.0f;
@@ -1100,34 +1337,80 @@ void Game::createMazeAndBall() {
     // Create the maze
     maze_ = std::make_unique<Maze>(worldId_);
     maze_->create(*current_level_, maze_world_origin_meters_);
+    if (renderer_) {
+        maze_->buildRenderCache(renderer_);
+    }
 
-    // Create the ball
-    b2Vec2 ball_start_grid_pos = levelData->ball_start_position;
-    float ball_start_x_meters = maze_world_origin_meters_.x + (ball_start_grid_pos.x + 0.5f) * (TILE_SIZE / PPM);
-    float ball_start_y_meters = maze_world_origin_meters_.y + (ball_start_grid_pos.y + 0.5f) * (TILE_SIZE / PPM);
+    // Create the balls. The body userData is the ball index + 1 so sensor events can be
+    // mapped back to a ball; crates and maze walls keep a null userData.
     float ball_radius_meters = (TILE_SIZE / PPM) * 0.45f;
-    ball_ = std::make_unique<Ball>(worldId_);
-    ball_->create({ball_start_x_meters, ball_start_y_meters}, ball_radius_meters);
+    for (const auto& start_position : levelData->ball_start_positions) {
+        auto ball = std::make_unique<Ball>(worldId_);
+        ball->create(gridToWorld(start_position), ball_radius_meters);
+        b2Body_SetUserData(ball->getBodyId(), reinterpret_cast<void*>(static_cast<uintptr_t>(balls_.size() + 1)));
+        balls_.push_back(std::move(ball));
+    }
+    if (balls_.empty()) {
+        std::cerr << "Level has no ball start position ('O')" << std::endl;
+    }
+
+    // Crates fill most of their tile so they can still be pushed down one-tile corridors
+    for (const auto& crate_position : levelData->crate_positions) {
+        auto crate = std::make_unique<Crate>(worldId_);
+        crate->create(gridToWorld(crate_position), (TILE_SIZE / PPM) * 0.4f);
+        crates_.push_back(std::move(crate));
+    }
+
+    // Holes, goal, warps and reverse items are sensors on the maze body. Box2D reports an
+    // overlap once the centers are closer than sensor radius + ball radius, so each radius
+    // below reproduces the trigger distance of the old per-frame checks.
+    const float tile_meters = TILE_SIZE / PPM;
+
+    // Holes trigger once the ball center is inside 45% of the tile; a sensor needs some radius
+    float hole_sensor_radius = std::max(tile_meters * 0.45f - ball_radius_meters, tile_meters * 0.02f);
+    const auto& hole_positions = levelData->hole_positions;
+    for (size_t i = 0; i < hole_positions.size(); ++i) {
+        maze_->addSensor(maze_->gridToLocal(hole_positions[i]), hole_sensor_radius,
+                         Trigger::pack(TriggerType::HOLE, static_cast<int>(i)));
+    }
+
+    // Goal triggers on touch
+    maze_->addSensor(maze_->gridToLocal(levelData->goal_position), tile_meters * 0.5f,
+                     Trigger::pack(TriggerType::GOAL, 0));
 
-    // Create warp objects
+    // Create warp objects. Warps trigger at sqrt(0.7) of the touching distance so the ball
+    // has to actually roll onto them.
+    float warp_radius = tile_meters * 0.5f;
+    float warp_sensor_radius = std::sqrt(0.7f) * (ball_radius_meters + warp_radius) - ball_radius_meters;
     for (const auto& [id, pos] : levelData->warp_positions) {
-        b2Vec2 world_pos = {
-            maze_world_origin_meters_.x + (pos.x + 0.5f) * (TILE_SIZE / PPM),
-            maze_world_origin_meters_.y + (pos.y + 0.5f) * (TILE_SIZE / PPM)
-        };
-        warps_.push_back(std::make_unique<Warp>(worldId_, id, world_pos, (TILE_SIZE / PPM) * 0.5f));
+        b2Vec2 local_pos = maze_->gridToLocal(pos);
+        maze_->addSensor(local_pos, warp_sensor_radius, Trigger::pack(TriggerType::WARP, static_cast<int>(warps_.size())));
+        warps_.push_back(std::make_unique<Warp>(maze_->getBodyId(), id, local_pos, warp_radius));
     }
 
-    // Create reverse items
+    // Create reverse items, triggered on touch
     for (const auto& pos : levelData->reverse_item_positions) {
-        float item_x_meters = maze_world_origin_meters_.x + (pos.x + 0.5f) * (TILE_SIZE / PPM);
-        float item_y_meters = maze_world_origin_meters_.y + (pos.y + 0.5f) * (TILE_SIZE / PPM);
-        float item_size_meters = (TILE_SIZE / PPM) * 0.8f;
-        auto reverse_item = std::make_unique<ReverseItem>(worldId_);
-        reverse_item->create({item_x_meters, item_y_meters}, item_size_meters);
+        b2Vec2 local_pos = maze_->gridToLocal(pos);
+        float item_size_meters = tile_meters * 0.8f;
+        maze_->addSensor(local_pos, item_size_meters / 2.0f,
+                         Trigger::pack(TriggerType::REVERSE_ITEM, static_cast<int>(reverse_items_.size())));
+        auto reverse_item = std::make_unique<ReverseItem>(maze_->getBodyId());
+        reverse_item->create(local_pos, item_size_meters);
         reverse_items_.push_back(std::move(reverse_item));
     }
 
+    b2Vec2 half_maze = {levelData->width * tile_meters / 2.0f, levelData->height * tile_meters / 2.0f};
+    b2Vec2 item_half_size = {tile_meters / 2.0f, tile_meters / 2.0f};
+    maze_item_grid_.reset({b2Neg(half_maze), half_maze}, GRID_CELL_TILES * tile_meters);
+    for (size_t i = 0; i < warps_.size(); ++i) {
+        b2Vec2 center = warps_[i]->getLocalPosition();
+        maze_item_grid_.insert(static_cast<int>(i), {b2Sub(center, item_half_size), b2Add(center, item_half_size)});
+    }
+    for (size_t i = 0; i < reverse_items_.size(); ++i) {
+        b2Vec2 center = reverse_items_[i]->getLocalPosition();
+        maze_item_grid_.insert(static_cast<int>(warps_.size() + i), {b2Sub(center, item_half_size), b2Add(center, item_half_size)});
+    }
+
     // 4. Update the camera
     updateCameraOffsets();
 
@@ -1157,7 +1440,8 @@ void Game::updateCameraOffsets() {
         maze_world_origin_meters_.y + unrotated_maze_height_m / 2.0f
     };
 
-    float angle_rad = maze_->getCurrentRotationRad();
+    // Follow what is drawn this frame, not the latest physics state
+    float angle_rad = b2Rot_GetAngle(maze_->getInterpolatedTransform(render_alpha_).q);
     float cos_a = std::cos(angle_rad);
     float sin_a = std::sin(angle_rad);
 
@@ -1188,8 +1472,17 @@ void Game::updateCameraOffsets() {
     if (effective_maze_width_pixels <= SCREEN_WIDTH && effective_maze_height_pixels <= SCREEN_HEIGHT) {
         camera_offset_x_ = (SCREEN_WIDTH - effective_maze_width_pixels) / 2.0f - effective_maze_origin_x_pixels;
         camera_offset_y_ = (SCREEN_HEIGHT - effective_maze_height_pixels) / 2.0f - effective_maze_origin_y_pixels;
-    } else if (ball_) {
-        b2Vec2 ball_pos_m = ball_->getPosition();
+    } else if (balls_in_goal_ < static_cast<int>(balls_.size())) {
+        // Follow the middle of the balls still in play
+        b2Vec2 ball_pos_m = {0.0f, 0.0f};
+        int balls_in_play = 0;
+        for (const auto& ball : balls_) {
+            if (ball->isActive()) {
+                ball_pos_m = b2Add(ball_pos_m, ball->getInterpolatedTransform(render_alpha_).p);
+                balls_in_play++;
+            }
+        }
+        ball_pos_m = b2MulSV(1.0f / balls_in_play, ball_pos_m);
         float ball_screen_x_abs_pixels = ball_pos_m.x * PPM;
         float ball_screen_y_abs_pixels = ball_pos_m.y * PPM;
 
@@ -1216,9 +1509,8 @@ void Game::updateCameraOffsets() {
 }
 
 void Game::cleanup() {
-    if (ball_) {
-        ball_.reset();
-    }
+    balls_.clear();
+    crates_.clear();
     if (maze_) {
         maze_.reset();
     }
@@ -1235,12 +1527,21 @@ void Game::cleanup() {
     }
     warps_.clear();
     
+    if (replay_writer_) {
+        finishRecording();
+    }
+
     // Clean up Box2D world
     if (b2World_IsValid(worldId_)) {
+        std::lock_guard<std::mutex> lock(world_table_mutex);
         b2DestroyWorld(worldId_);
         worldId_ = b2_nullWorldId;
     }
+    task_scheduler_.reset(); // Joins the solver threads; the world no longer calls into them
     
+    // Cached text textures reference the renderer and fonts
+    text_cache_.clear();
+
     // Clean up fonts
     if (font_) {
         TTF_CloseFont(font_);
@@ -1258,48 +1559,24 @@ void Game::cleanup() {
         renderer_ = nullptr;
     }
     
+    if (headless_surface_) {
+        SDL_FreeSurface(headless_surface_);
+        headless_surface_ = nullptr;
+    }
+
     if (window_) {
         SDL_DestroyWindow(window_);
         window_ = nullptr;
     }
     
-    // Quit SDL_ttf
-    TTF_Quit();
-    
-    // Quit SDL
-    SDL_Quit();
-}
-
-// Helper function to draw a circle using SDL_RenderDrawPoint
-void SDL_RenderDrawCircle(SDL_Renderer* renderer, int center_x, int center_y, int radius) {
-    const int diameter = radius * 2;
-    int x = radius - 1;
-    int y = 0;
-    int tx = 1;
-    int ty = 1;
-    int error = tx - diameter;
-
-    while (x >= y) {
-        // Draw 8 points for each octant
-        SDL_RenderDrawPoint(renderer, center_x + x, center_y - y);
-        SDL_RenderDrawPoint(renderer, center_x + x, center_y + y);
-        SDL_RenderDrawPoint(renderer, center_x - x, center_y - y);
-        SDL_RenderDrawPoint(renderer, center_x - x, center_y + y);
-        SDL_RenderDrawPoint(renderer, center_x + y, center_y - x);
-        SDL_RenderDrawPoint(renderer, center_x + y, center_y + x);
-        SDL_RenderDrawPoint(renderer, center_x - y, center_y - x);
-        SDL_RenderDrawPoint(renderer, center_x - y, center_y + x);
-
-        if (error <= 0) {
-            y++;
-            error += ty;
-            ty += 2;
-        }
-        if (error > 0) {
-            x--;
-            tx += 2;
-            error += tx - diameter;
-        }
+    // Headless games never initialized SDL, and may be shutting down on a worker thread
+    if (sdl_initialized_) {
+        // Quit SDL_ttf
+        TTF_Quit();
+
+        // Quit SDL
+        SDL_Quit();
+        sdl_initialized_ = false;
     }
 }
 
@@ -8,13 +8,23 @@
 #include <string>
 #include <vector>
 #include <filesystem>
+#include <future>
 
 #include "constants.h"
 #include "Level.h"
 #include "Maze.h"
 #include "Ball.h"
+#include "Crate.h"
 #include "ReverseItem.h"
 #include "Warp.h"
+#include "TextCache.h"
+#include "TaskScheduler.h"
+#include "Replay.h"
+#include "SpatialGrid.h"
+#include "Profiler.h"
+#include "FramePacer.h"
+#include "BatchRenderer.h"
+#include "LevelWatcher.h"
 
 // Define game states
 enum class GameState {
@@ -24,33 +34,79 @@ enum class GameState {
     LEVEL_COMPLETE
 };
 
-// Structure to hold level pack metadata
-struct LevelPackInfo {
-    std::string filepath;
-    std::string name;
-    std::string description;
-    std::string author;
-    std::string date;
-};
-
 class Game {
 public:
     Game();
     ~Game();
 
+    // Threads for Box2D's solver, counting the main thread; 0 picks one per hardware
+    // thread and 1 keeps Box2D single-threaded. Takes effect in init()/initHeadless().
+    void setWorkerCount(int worker_count) { requested_worker_count_ = worker_count; }
+    int getWorkerCount() const { return task_scheduler_ ? task_scheduler_->getWorkerCount() : 1; }
+
+    // With adaptive physics (the default) every b2World_Step picks its own length and sub-step
+    // count, see choosePhysicsStep; off, each step is TIME_STEP with POSITION_ITERATIONS
+    // sub-steps. Replays switch it to whatever they were recorded with.
+    void setAdaptivePhysics(bool adaptive) { adaptive_physics_ = adaptive; }
+
+    // Frame pacing, set before init(). The cap defaults to 60 fps; 0 removes it. vsync asks
+    // the renderer for SDL_RENDERER_PRESENTVSYNC.
+    void setFrameRateCap(int fps_cap) { frame_pacer_.setFrameRateCap(fps_cap); }
+    void setVSync(bool vsync) { vsync_requested_ = vsync; }
+
     bool init();
     bool loadLevel(const std::string& level_filepath);
+    bool loadLevel(std::unique_ptr<Level> level); // A pack that is already open, e.g. generated levels
     void run();
     
     // New methods for level pack selection
     void loadLevelPacks();
     bool loadSelectedLevelPack();
 
+    // Endless mode plays generated levels one after another, a difficulty step every
+    // ENDLESS_LEVELS_PER_DIFFICULTY levels. The next level is generated in the background
+    // while the current one is played. A seed of 0 picks one from the clock.
+    void setEndlessSeed(uint64_t seed) { endless_seed_ = seed; }
+    bool startEndless();
+    static constexpr int ENDLESS_LEVELS_PER_DIFFICULTY = 3;
+
+    // Headless simulation API: no window, renderer or fonts. Gameplay runs through the
+    // same updateGameplay() path as the windowed game, one fixed TIME_STEP per call.
+    // software_render draws into an offscreen surface so renderFrame() can be timed
+    bool initHeadless(bool software_render = false);
+    bool startLevel(int level_index); // Builds the maze for a level of the loaded pack and enters GAMEPLAY
+    // Advances the game by TIME_STEP; rotation_input: -1 left key, 1 right key, 0 none
+    void stepSimulation(int rotation_input);
+    void renderFrame() { if (renderer_) render(); }
+    bool isLevelWon() const { return is_level_won_; }
+    int getLevelCount() const { return current_level_ ? current_level_->getTotalLevels() : 0; }
+    const Level* getLevel() const { return current_level_.get(); }
+    // Replays. With a record directory set, every level played from the start screen is
+    // saved there. A replay rebuilds its level and feeds the recorded frames back through
+    // updateGameplay(); finishReplay() reports whether the end state matches bit for bit.
+    void setRecordDirectory(const std::string& directory) { record_directory_ = directory; }
+    bool runReplay(const std::string& replay_path, bool fast_forward); // Windowed playback, TAB toggles fast-forward
+    bool beginReplay(const std::string& replay_path);
+    bool stepReplay(); // One recorded frame; false once the replay is over
+    bool finishReplay();
+    uint64_t getPhysicsStepCount() const { return physics_step_count_; }
+    uint64_t getSubStepCount() const { return sub_step_count_; } // Box2D's solver work, summed over the steps
+    uint64_t hashSimulationState() const; // Ball, crate and maze transforms and velocities
+
+    const Ball* getBall() const { return balls_.empty() ? nullptr : balls_.front().get(); } // First ball
+    int getBallCount() const { return static_cast<int>(balls_.size()); }
+    int getBallsInGoal() const { return balls_in_goal_; }
+    int getCrateCount() const { return static_cast<int>(crates_.size()); }
+    b2WorldId getWorldId() const { return worldId_; }
+    const Maze* getMaze() const { return maze_.get(); }
+    const BatchRenderer& getBatchRenderer() const { return batch_; } // Draw call and triangle totals
+    bool areControlsInverted() const { return controls_inverted_; } // A reverse item is active
+    Profiler& getProfiler() { return profiler_; } // Headless callers bracket their steps with begin/endFrame
+
 private:
-    // Helper function to draw a circle
-    static void SDL_RenderDrawCircle(SDL_Renderer* renderer, int center_x, int center_y, int radius);
-    
     void processInput();
+    // Rebuilds what lived in lost render targets or textures; runs ahead of every screen's input
+    void handleRenderResets();
     void update(float delta_time);
     void render();
     void cleanup();
@@ -71,7 +127,36 @@ private:
     void processGameplayInput();
     void updateGameplay(float delta_time);
     void renderGameplay();
+
+    // Sensor handling: Box2D tells us when the ball starts or stops overlapping a maze
+    // sensor, and only the sensors currently overlapped are looked at each frame.
+    void processSensorEvents(); // Call after every b2World_Step
+
+    // Length of the next b2World_Step in quarters of TIME_STEP, and its sub-step count
+    struct PhysicsStep {
+        int quarter_ticks;
+        int sub_steps;
+    };
+    PhysicsStep choosePhysicsStep() const;
+    void handleActiveTriggers();
+    void applyGameplayInput(int rotation_input, bool reset); // Shared by live play, headless runs and replays
+    bool appendEndlessLevel(); // Adds the next generated level to the endless pack
+    void prefetchEndlessLevel(int index);
+    void startRecording();
+    void finishRecording();
+    void deliverBall(int ball_index); // A ball reached the goal: park it and count it
+    void resetBallsToStart(); // Every ball and crate back to its start tile, maze back to 0 rotation
+    b2Vec2 gridToWorld(b2Vec2 grid_position) const; // Tile center in world meters, unrotated maze
+    void renderProfilerOverlay();
+    void exportProfilerTrace(); // Writes trace-<date>-<time>.json to the working directory
+    // Handles packs level_watcher_ saw change: the open level is rebuilt from the edited file
+    // in place, keeping the level index and camera; the start screen re-reads pack metadata
+    void reloadChangedLevelFiles();
     
+    // Draw a string through text_cache_; the centered variant centers it horizontally on screen
+    void renderText(TTF_Font* font, const std::string& text, SDL_Color color, int x, int y);
+    void renderCenteredText(TTF_Font* font, const std::string& text, SDL_Color color, int y, int wrap_width = 0);
+
     // Helper method to create or recreate the maze and ball based on current level
     void createMazeAndBall();
     
@@ -83,20 +168,50 @@ private:
 
     SDL_Window* window_;
     SDL_Renderer* renderer_;
+    SDL_Surface* headless_surface_ = nullptr; // Target of the software renderer in headless runs
     bool is_running_;
-    Uint32 last_tick_;
+    bool sdl_initialized_ = false; // Only init() does; headless games leave SDL alone
+    bool vsync_requested_ = false;
+    bool vsync_ = false; // The renderer really presents on vertical sync
+    FramePacer frame_pacer_;
+    LevelWatcher level_watcher_; // Only run() starts it; replays and headless runs keep files fixed
+
 
+    bool createWorld(); // Shared by init() and initHeadless()
 
     b2WorldId worldId_;
+    int requested_worker_count_ = 0;
+    std::unique_ptr<TaskScheduler> task_scheduler_; // Must outlive worldId_
     float time_accumulator_ = 0.0f;
+    uint64_t physics_step_count_ = 0; // Since the level was built
+    uint64_t sub_step_count_ = 0;
+    bool adaptive_physics_ = true;
+    float time_since_impact_ = 0.0f; // Simulated seconds since the last Box2D hit event
+    float last_step_seconds_ = TIME_STEP;
+    float render_alpha_ = 1.0f; // Leftover accumulator as a fraction of the last step, for render interpolation
 
     std::unique_ptr<Level> current_level_;
     std::unique_ptr<Maze> maze_;
-    std::unique_ptr<Ball> ball_;
+    std::vector<std::unique_ptr<Ball>> balls_; // Body userData holds index + 1, see createMazeAndBall
+    std::vector<std::unique_ptr<Crate>> crates_;
+    std::vector<b2BodyId> chunk_probe_bodies_; // Balls and crates, for Maze::updateActiveChunks
+    int balls_in_goal_ = 0; // The level is won when every ball has reached the goal
     
     // Game objects
     std::vector<std::unique_ptr<ReverseItem>> reverse_items_;
     std::vector<std::unique_ptr<Warp>> warps_;
+    // Warps (ids 0..warps_.size()-1) and reverse items (the ids after) in maze body coordinates,
+    // so renderGameplay only draws those near the screen
+    SpatialGrid maze_item_grid_;
+    std::vector<int> visible_items_;
+
+    // A maze sensor overlapped by one of the balls
+    struct SensorContact {
+        b2ShapeId sensor;
+        b2ShapeId ball_shape;
+        int ball_index;
+    };
+    std::vector<SensorContact> active_sensors_;
     
     // For warp cooldown to prevent immediate re-triggering
     bool is_warp_cooldown_ = false;
@@ -122,10 +237,28 @@ private:
     // Level pack selection
     std::vector<LevelPackInfo> level_packs_;
     size_t current_level_pack_index_ = 0;
+
+    // Endless mode
+    bool endless_ = false;
+    uint64_t endless_seed_ = 0;
+    std::future<LevelData> next_endless_level_; // Empty layout if generation failed
     
+    // Replay recording and playback
+    std::string record_directory_;
+    std::unique_ptr<ReplayWriter> replay_writer_;
+    std::unique_ptr<ReplayReader> replay_reader_;
+    ReplayFrame frame_input_;       // Input gathered by processGameplayInput this frame
+    ReplaySummary replay_summary_;  // State after the last recorded frame
+
     // Font for rendering text
     TTF_Font* font_ = nullptr;
     TTF_Font* title_font_ = nullptr;
+    TextCache text_cache_;
+    BatchRenderer batch_; // Maze shapes, crates, balls and items; flushed once per gameplay frame
+
+    // Frame timings: F3 shows the graph, F4 saves a Chrome trace
+    Profiler profiler_;
+    bool show_profiler_ = false;
 };
 
 #endif // GAME_H
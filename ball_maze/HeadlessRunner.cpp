@@ -0,0 +1,350 @@
+#include "HeadlessRunner.h"
+#include "Game.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+namespace {
+
+// Silences std::cout (the gameplay code logs a lot) while the simulation runs
+class QuietStdout {
+public:
+    explicit QuietStdout(bool enabled) : saved_(nullptr) {
+        if (enabled) {
+            saved_ = std::cout.rdbuf(nullptr);
+        }
+    }
+    ~QuietStdout() {
+        if (saved_) {
+            std::cout.rdbuf(saved_); // Also clears the badbit set while muted
+        }
+    }
+
+private:
+    std::streambuf* saved_;
+};
+
+float percentile(std::vector<float> values, float fraction) {
+    if (values.empty()) {
+        return 0.0f;
+    }
+    size_t index = static_cast<size_t>(fraction * (values.size() - 1) + 0.5f);
+    std::nth_element(values.begin(), values.begin() + index, values.end());
+    return values[index];
+}
+
+} // namespace
+
+HeadlessRunner::HeadlessRunner(const HeadlessConfig& config) : config_(config) {
+}
+
+bool HeadlessRunner::loadScript(const std::string& path, std::vector<RotationSegment>& script) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        std::cerr << "Error: Could not open input script: " << path << std::endl;
+        return false;
+    }
+
+    script.clear();
+    std::string line;
+    int line_number = 0;
+    while (std::getline(file, line)) {
+        line_number++;
+        line.erase(0, line.find_first_not_of(" \t\r"));
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+
+        std::istringstream fields(line);
+        RotationSegment segment = {0, 0};
+        std::string input;
+        if (!(fields >> segment.steps >> input) || segment.steps <= 0) {
+            std::cerr << "Error: Bad script line " << line_number << ": '" << line << "'" << std::endl;
+            return false;
+        }
+
+        if (input == "L" || input == "-1") {
+            segment.input = -1;
+        } else if (input == "R" || input == "1") {
+            segment.input = 1;
+        } else if (input == "N" || input == "0") {
+            segment.input = 0;
+        } else {
+            std::cerr << "Error: Bad input '" << input << "' on script line " << line_number << std::endl;
+            return false;
+        }
+        script.push_back(segment);
+    }
+
+    if (script.empty()) {
+        std::cerr << "Error: Input script is empty: " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool HeadlessRunner::playSolution(const LevelData& level_data, const std::vector<int>& solution,
+                                  int rotation_buckets, float* simulated_seconds) {
+    const int SETTLE_STEPS = static_cast<int>(0.25f / TIME_STEP);    // Still for this long counts as at rest
+    const int MAX_PHASE_STEPS = static_cast<int>(10.0f / TIME_STEP); // Per turn, and per wait to settle
+    const float REST_SPEED = 0.05f;                                  // m/s
+    const float BUCKET_RADIANS = 2.0f * static_cast<float>(M_PI) / rotation_buckets;
+
+    Game game;
+    game.setWorkerCount(1);
+    auto level = std::make_unique<Level>();
+    if (!level->loadFromLevels("validation", {level_data}) || !game.initHeadless() ||
+        !game.loadLevel(std::move(level)) || !game.startLevel(0)) {
+        return false;
+    }
+
+    int steps = 0;
+    auto settle = [&]() {
+        int still_steps = 0;
+        for (int i = 0; i < MAX_PHASE_STEPS && still_steps < SETTLE_STEPS && !game.isLevelWon(); ++i) {
+            game.stepSimulation(0);
+            steps++;
+            const Ball* ball = game.getBall();
+            float speed = ball ? b2Length(ball->getVelocity()) : 0.0f;
+            bool maze_turning = std::fabs(b2Body_GetAngularVelocity(game.getMaze()->getBodyId())) > 0.001f;
+            still_steps = (speed < REST_SPEED && !maze_turning) ? still_steps + 1 : 0;
+        }
+    };
+
+    settle();
+    float target_angle = 0.0f;
+    for (size_t turn = 0; turn < solution.size() && !game.isLevelWon(); ++turn) {
+        target_angle += solution[turn] * BUCKET_RADIANS;
+
+        // Hold the key until the maze is close enough to coast onto the target; Maze::update
+        // damps the released maze by 0.9 per step, i.e. it turns about 9 more steps' worth
+        for (int i = 0; i < MAX_PHASE_STEPS && !game.isLevelWon(); ++i) {
+            float remaining = std::remainder(target_angle - game.getMaze()->getCurrentRotationRad(), 2.0f * static_cast<float>(M_PI));
+            float coast = std::fabs(b2Body_GetAngularVelocity(game.getMaze()->getBodyId())) * TIME_STEP * 9.0f;
+            if (std::fabs(remaining) <= coast + 0.01f) {
+                break;
+            }
+            int direction = remaining > 0.0f ? 1 : -1;
+            game.stepSimulation(game.areControlsInverted() ? -direction : direction); // Undo the reverse item
+            steps++;
+        }
+        settle();
+    }
+    settle(); // The last roll may still be on its way to the goal
+
+    if (simulated_seconds) {
+        *simulated_seconds = steps * TIME_STEP;
+    }
+    return game.isLevelWon();
+}
+
+int HeadlessRunner::run() {
+    if (!config_.replay_path.empty()) {
+        return runReplay();
+    }
+
+    if (config_.script_path.empty()) {
+        // Default sweep: two seconds each way with a one second rest in between
+        script_ = {{240, 1}, {120, 0}, {240, -1}, {120, 0}};
+    } else if (!loadScript(config_.script_path, script_)) {
+        return 1;
+    }
+
+    Game game;
+    game.setWorkerCount(config_.worker_count);
+    game.setAdaptivePhysics(config_.adaptive_physics);
+    {
+        QuietStdout quiet(!config_.verbose);
+        if (!game.initHeadless(config_.render)) {
+            return 1;
+        }
+        if (!game.loadLevel(config_.level_pack_path)) {
+            std::cerr << "Error: Could not load level pack: " << config_.level_pack_path << std::endl;
+            return 1;
+        }
+    }
+
+    int first = config_.all_levels ? 0 : config_.level_index;
+    int last = config_.all_levels ? game.getLevelCount() - 1 : config_.level_index;
+    if (first < 0 || last >= game.getLevelCount()) {
+        std::cerr << "Error: Level " << (config_.level_index + 1) << " not in pack ("
+                  << game.getLevelCount() << " levels)" << std::endl;
+        return 1;
+    }
+
+    std::cout << "Box2D workers: " << game.getWorkerCount() << std::endl;
+
+    bool ok = true;
+    for (int level_index = first; level_index <= last; ++level_index) {
+        ok = runLevel(game, level_index) && ok;
+    }
+    return ok ? 0 : 1;
+}
+
+bool HeadlessRunner::runLevel(Game& game, int level_index) {
+    std::vector<float> step_times_ms;
+    std::vector<float> render_times_ms;
+    step_times_ms.reserve(config_.max_steps);
+    if (config_.render) {
+        render_times_ms.reserve(config_.max_steps);
+    }
+
+    int steps = 0;
+    long long enabled_chunk_sum = 0;
+    double elapsed_seconds = 0.0;
+    int draw_calls_before = game.getBatchRenderer().getDrawCalls();
+    long long triangles_before = game.getBatchRenderer().getTriangleCount();
+    {
+        QuietStdout quiet(!config_.verbose);
+        if (!game.startLevel(level_index)) {
+            return false;
+        }
+
+        size_t segment = 0;
+        int segment_steps_left = script_[0].steps;
+
+        auto start = std::chrono::steady_clock::now();
+        while (steps < config_.max_steps && !game.isLevelWon()) {
+            if (segment_steps_left == 0) {
+                segment = (segment + 1) % script_.size(); // Script repeats until max_steps
+                segment_steps_left = script_[segment].steps;
+            }
+
+            uint64_t physics_steps = game.getPhysicsStepCount();
+            game.stepSimulation(script_[segment].input);
+            segment_steps_left--;
+            steps++;
+            enabled_chunk_sum += game.getMaze() ? game.getMaze()->getEnabledChunkCount() : 0;
+
+            // The profile holds the timings of the last b2World_Step. With adaptive physics a
+            // call may run several steps or none; only the last of several is timed
+            if (game.getPhysicsStepCount() != physics_steps) {
+                step_times_ms.push_back(b2World_GetProfile(game.getWorldId()).step);
+            }
+
+            if (config_.render) {
+                auto render_start = std::chrono::steady_clock::now();
+                game.renderFrame();
+                render_times_ms.push_back(std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - render_start).count());
+            }
+        }
+        elapsed_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    const Level* level = game.getLevel();
+    const Ball* ball = game.getBall();
+    b2Vec2 ball_pos = ball ? ball->getPosition() : b2Vec2{0.0f, 0.0f};
+    b2Vec2 ball_vel = ball ? ball->getVelocity() : b2Vec2{0.0f, 0.0f};
+
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "Level " << (level_index + 1) << "/" << game.getLevelCount()
+              << " '" << (level ? level->getName() : "") << "': "
+              << steps << " steps in " << elapsed_seconds << " s ("
+              << std::setprecision(0) << (elapsed_seconds > 0.0 ? steps / elapsed_seconds : 0.0)
+              << " steps/s)" << std::endl;
+    std::cout << "  Bodies: " << game.getBallCount() << " balls, " << game.getCrateCount()
+              << " crates; " << game.getBallsInGoal() << " balls in goal" << std::endl;
+    std::cout << "  Physics: " << game.getPhysicsStepCount() << " b2World_Steps, " << game.getSubStepCount()
+              << " sub-steps (fixed stepping: " << steps << ", " << static_cast<uint64_t>(steps) * POSITION_ITERATIONS
+              << ")" << std::endl;
+    if (const Maze* maze = game.getMaze()) {
+        std::cout << std::setprecision(1) << "  Wall chunks: " << maze->getChunkCount() << " bodies, "
+                  << (steps > 0 ? static_cast<double>(enabled_chunk_sum) / steps : 0.0) << " enabled on average" << std::endl;
+    }
+    std::cout << std::setprecision(4);
+    std::cout << "  b2World_Step: p50 " << percentile(step_times_ms, 0.50f)
+              << " ms, p99 " << percentile(step_times_ms, 0.99f) << " ms, max "
+              << (step_times_ms.empty() ? 0.0f : *std::max_element(step_times_ms.begin(), step_times_ms.end()))
+              << " ms" << std::endl;
+    if (config_.render) {
+        std::cout << "  Render:       p50 " << percentile(render_times_ms, 0.50f)
+                  << " ms, p99 " << percentile(render_times_ms, 0.99f) << " ms, max "
+                  << (render_times_ms.empty() ? 0.0f : *std::max_element(render_times_ms.begin(), render_times_ms.end()))
+                  << " ms" << std::endl;
+        size_t frames = std::max<size_t>(1, render_times_ms.size());
+        std::cout << std::setprecision(1) << "  Batches:      "
+                  << static_cast<double>(game.getBatchRenderer().getDrawCalls() - draw_calls_before) / frames
+                  << " SDL_RenderGeometry calls, "
+                  << static_cast<double>(game.getBatchRenderer().getTriangleCount() - triangles_before) / frames
+                  << " triangles per frame" << std::endl;
+    }
+    std::cout << std::setprecision(6);
+    std::cout << "  Final ball: pos (" << ball_pos.x << ", " << ball_pos.y << ") vel ("
+              << ball_vel.x << ", " << ball_vel.y << ") angle " << (ball ? ball->getAngle() : 0.0f)
+              << (game.isLevelWon() ? " [goal reached]" : "") << std::endl;
+    std::cout.unsetf(std::ios_base::floatfield);
+    return true;
+}
+
+int HeadlessRunner::runReplay() {
+    Game game;
+    game.setWorkerCount(config_.worker_count);
+    {
+        QuietStdout quiet(!config_.verbose);
+        if (!game.initHeadless(config_.render) || !game.beginReplay(config_.replay_path)) {
+            return 1;
+        }
+    }
+
+    // Replays are recorded at display rate, so time whole frames (any number of physics steps)
+    std::vector<float> frame_times_ms;
+    std::vector<float> render_times_ms;
+    int frames = 0;
+    double elapsed_seconds = 0.0;
+    {
+        QuietStdout quiet(!config_.verbose);
+        auto start = std::chrono::steady_clock::now();
+        Profiler& profiler = game.getProfiler();
+        while (true) {
+            profiler.beginFrame();
+            auto frame_start = std::chrono::steady_clock::now();
+            bool playing;
+            {
+                ScopedTimer timer(profiler, ProfilePhase::UPDATE);
+                playing = game.stepReplay();
+            }
+            if (!playing) {
+                break;
+            }
+            auto frame_end = std::chrono::steady_clock::now();
+            frame_times_ms.push_back(std::chrono::duration<float, std::milli>(frame_end - frame_start).count());
+            frames++;
+
+            if (config_.render) {
+                ScopedTimer timer(profiler, ProfilePhase::RENDER);
+                game.renderFrame();
+                render_times_ms.push_back(std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - frame_end).count());
+            }
+            profiler.endFrame();
+        }
+        elapsed_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    uint64_t steps = game.getPhysicsStepCount();
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "Replay " << config_.replay_path << ": " << frames << " frames, " << steps << " steps in "
+              << elapsed_seconds << " s (" << std::setprecision(0)
+              << (elapsed_seconds > 0.0 ? steps / elapsed_seconds : 0.0) << " steps/s)" << std::endl;
+    std::cout << std::setprecision(4);
+    std::cout << "  Frame update: p50 " << percentile(frame_times_ms, 0.50f)
+              << " ms, p99 " << percentile(frame_times_ms, 0.99f) << " ms, max "
+              << (frame_times_ms.empty() ? 0.0f : *std::max_element(frame_times_ms.begin(), frame_times_ms.end()))
+              << " ms" << std::endl;
+    if (config_.render) {
+        std::cout << "  Render:       p50 " << percentile(render_times_ms, 0.50f)
+                  << " ms, p99 " << percentile(render_times_ms, 0.99f) << " ms, max "
+                  << (render_times_ms.empty() ? 0.0f : *std::max_element(render_times_ms.begin(), render_times_ms.end()))
+                  << " ms" << std::endl;
+    }
+    std::cout.unsetf(std::ios_base::floatfield);
+
+    bool ok = game.finishReplay();
+    if (!config_.trace_path.empty() && !game.getProfiler().exportChromeTrace(config_.trace_path)) {
+        ok = false;
+    }
+    return ok ? 0 : 1;
+}
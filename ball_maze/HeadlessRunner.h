@@ -0,0 +1,56 @@
+#ifndef HEADLESS_RUNNER_H
+#define HEADLESS_RUNNER_H
+
+#include <string>
+#include <vector>
+
+class Game;
+struct LevelData;
+
+// One entry of a scripted rotation input stream: hold `input` for `steps` physics steps
+struct RotationSegment {
+    int steps;
+    int input; // -1 left key, 1 right key, 0 no key
+};
+
+struct HeadlessConfig {
+    std::string level_pack_path;
+    std::string script_path;   // Empty uses the built-in left/right sweep
+    std::string replay_path;   // Play this recording instead of a script (pack and level come from it)
+    int level_index = 0;       // 0-based level inside the pack
+    bool all_levels = false;   // Run every level of the pack one after another
+    int max_steps = 7200;      // 60 simulated seconds at TIME_STEP
+    int worker_count = 0;      // Box2D solver threads, 0 = one per hardware thread
+    bool adaptive_physics = true; // See Game::setAdaptivePhysics
+    bool verbose = false;      // Keep the game's std::cout logging
+    bool render = false;       // Also draw every step with SDL's software renderer and time it
+    std::string trace_path;    // Replays only: Chrome trace of the last Profiler::HISTORY_FRAMES frames
+};
+
+// Plays a rotation script against the real Maze/Ball/Warp gameplay code at a fixed step,
+// without a window, and reports physics throughput and b2World_Step timings.
+class HeadlessRunner {
+public:
+    explicit HeadlessRunner(const HeadlessConfig& config);
+
+    int run(); // Returns a process exit code
+
+    // Script format: one "<steps> <input>" pair per line, input is -1/0/1 or L/N/R.
+    // Blank lines and lines starting with '#' are ignored.
+    static bool loadScript(const std::string& path, std::vector<RotationSegment>& script);
+
+    // Plays a MazeAnalyzer route in the Box2D simulation: turns the maze one rotation bucket
+    // per entry of `solution`, letting the ball settle after each turn. True if the level is
+    // won. Builds its own single-threaded Game, so several can run on different threads.
+    static bool playSolution(const LevelData& level_data, const std::vector<int>& solution,
+                             int rotation_buckets, float* simulated_seconds = nullptr);
+
+private:
+    bool runLevel(Game& game, int level_index);
+    int runReplay(); // Exit code 1 if the replay doesn't reproduce the recorded end state
+
+    HeadlessConfig config_;
+    std::vector<RotationSegment> script_;
+};
+
+#endif // HEADLESS_RUNNER_H
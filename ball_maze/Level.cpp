@@ -1,36 +1,141 @@
 #include "Level.h"
+#include "LevelCache.h"
 #include <fstream>
 #include <iostream>
 #include <algorithm>
 #include <cctype>
 
-Level::Level() : current_level_index_(-1) {
+Level::Level() : level_count_(0), pack_cache_(std::make_unique<LevelCache>()), current_level_index_(-1) {
     // Initialize with empty levels
 }
 
+Level::~Level() = default;
+
 bool Level::loadFromFile(const std::string& filepath) {
-    std::cout << "Starting to load levels from file: " << filepath << std::endl;
-    
-    std::ifstream file(filepath);
-    if (!file.is_open()) {
-        std::cerr << "Error: Could not open level file: " << filepath << std::endl;
-        return false;
+    if (pack_compile_.valid()) {
+        pack_compile_.wait(); // Don't race a compile of the pack about to be opened
     }
-    
+
     // Store the filepath for potential reloading
     filepath_ = filepath;
     
     // Clear any existing levels
-    levels_.clear();
+    level_count_ = 0;
+    level_offsets_.clear();
+    generated_levels_.clear();
+    recent_levels_.clear();
     current_level_index_ = -1;
+
+    // Use the compiled pack when it is up to date: one mapped file, no text parsing
+    if (pack_cache_->open(filepath)) {
+        level_count_ = pack_cache_->getLevelCount();
+        std::cout << "Opened " << level_count_ << " levels from cache for " << filepath << std::endl;
+    } else {
+        if (!scanTextFile(filepath)) {
+            return false;
+        }
+        std::cout << "Indexed " << level_count_ << " levels in " << filepath << std::endl;
+
+        if (!loadLevelByIndex(0)) {
+            return false;
+        }
+        compilePackInBackground(); // Ready for the next time the pack is opened
+        return true;
+    }
+    
+    // Load the first level
+    return loadLevelByIndex(0);
+}
+
+void Level::compilePackInBackground() {
+    std::string filepath = filepath_;
+    std::string pack_name = pack_name_;
+    std::vector<std::streamoff> offsets = level_offsets_;
+    pack_compile_ = std::async(std::launch::async, [filepath, pack_name, offsets]() {
+        std::ifstream file(filepath);
+        if (!file.is_open()) {
+            return;
+        }
+        // One open stream for the whole pack, seeking to each level section in turn
+        LevelCache::writePack(filepath, static_cast<int>(offsets.size()), [&](int index, LevelData& level_data) {
+            return parseLevelAt(file, offsets[index], index, pack_name, level_data);
+        });
+    });
+}
+
+bool Level::loadFromLevels(const std::string& pack_name, std::vector<LevelData> levels) {
+    filepath_.clear();
+    pack_name_ = pack_name;
+    level_offsets_.clear();
+    recent_levels_.clear();
+    current_level_index_ = -1;
+    generated_levels_ = std::move(levels);
+    level_count_ = static_cast<int>(generated_levels_.size());
+    return level_count_ > 0 && loadLevelByIndex(0);
+}
+
+void Level::appendLevel(LevelData level_data) {
+    generated_levels_.push_back(std::move(level_data));
+    level_count_ = static_cast<int>(generated_levels_.size());
+}
+
+bool Level::reloadFromText(const std::string& filepath, int index) {
+    filepath_ = filepath;
+    level_count_ = 0;
+    level_offsets_.clear();
+    generated_levels_.clear();
+    recent_levels_.clear();
+    current_level_index_ = -1;
+    pack_cache_->close();
+
+    if (!scanTextFile(filepath)) {
+        return false;
+    }
+    return loadLevelByIndex(std::max(0, std::min(index, level_count_ - 1)));
+}
+
+bool Level::saveToFile(const std::string& filepath, const LevelPackInfo& pack_info, const std::vector<LevelData>& levels) {
+    std::ofstream file(filepath);
+    if (!file.is_open()) {
+        std::cerr << "Error: Could not create level file: " << filepath << std::endl;
+        return false;
+    }
+
+    // Same layout as the hand-written packs: pack metadata, then a blank line before each level
+    file << "; Name: " << pack_info.name << "\n";
+    file << "; Description: " << pack_info.description << "\n";
+    file << "; Author: " << pack_info.author << "\n";
+    file << "; Date: " << pack_info.date << "\n";
+    for (const LevelData& level_data : levels) {
+        file << "\n; Name: " << level_data.name << "\n";
+        if (!level_data.description.empty()) {
+            file << "; Description: " << level_data.description << "\n";
+        }
+        if (!level_data.difficulty.empty()) {
+            file << "; Difficulty: " << level_data.difficulty << "\n";
+        }
+        for (const std::string& row : level_data.layout) {
+            file << row << "\n";
+        }
+    }
+
+    if (!file.good()) {
+        std::cerr << "Error: Failed writing level file: " << filepath << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool Level::scanTextFile(const std::string& filepath) {
+    std::ifstream file(filepath);
+    if (!file.is_open()) {
+        std::cerr << "Error: Could not open level file: " << filepath << std::endl;
+        return false;
+    }
     
     // Read level pack metadata first (at the top of the file)
     std::string line;
-    std::string level_pack_name;
-    std::string level_pack_description;
-    std::string level_pack_author;
-    std::string level_pack_difficulty;
-    std::string level_pack_date;
+    pack_name_.clear();
     
     // Process initial metadata until we find a section header or grid data
     bool found_section_header = false;
@@ -58,32 +163,20 @@ bool Level::loadFromFile(const std::string& filepath) {
             
             if (metadata.find("Name: ") == 0) {
                 // Check if this is the first Name: field we've encountered
-                if (level_pack_name.empty()) {
-                    level_pack_name = metadata.substr(6);
-                    std::cout << "Level pack name: " << level_pack_name << std::endl;
+                if (pack_name_.empty()) {
+                    pack_name_ = metadata.substr(6);
                 } else {
                     // If we already have a level pack name, this is the start of the first level
                     found_section_header = true;
                     section_start_pos = line_start_pos;
-                    std::cout << "Found first level with name: '" << metadata << "'" << std::endl;
                 }
-            } else if (metadata.find("Description: ") == 0) {
-                level_pack_description = metadata.substr(13);
-                std::cout << "Level pack description: " << level_pack_description << std::endl;
-            } else if (metadata.find("Author: ") == 0) {
-                level_pack_author = metadata.substr(8);
-                std::cout << "Level pack author: " << level_pack_author << std::endl;
-            } else if (metadata.find("Date: ") == 0) {
-                level_pack_date = metadata.substr(6);
-                std::cout << "Level pack date: " << level_pack_date << std::endl;
-            } else if (metadata.find("Difficulty: ") == 0) {
-                level_pack_difficulty = metadata.substr(12);
-                std::cout << "Level pack difficulty: " << level_pack_difficulty << std::endl;
+            } else if (metadata.find("Description: ") == 0 || metadata.find("Author: ") == 0 ||
+                       metadata.find("Date: ") == 0 || metadata.find("Difficulty: ") == 0) {
+                // Pack metadata; the start screen reads it through LevelCache::scanLevelPacks
             } else {
                 // Any other comment line after the metadata is considered a level section header
                 found_section_header = true;
                 section_start_pos = line_start_pos;
-                std::cout << "Found first section header: '" << metadata << "'" << std::endl;
             }
         } else {
             // Found grid data, rewind to start of this line
@@ -101,67 +194,34 @@ bool Level::loadFromFile(const std::string& filepath) {
         file.seekg(start_pos);
     }
     
-    // Parse all levels from the file
-    int line_number = 1;
-    LevelData level_data;
-    int level_count = 0;
-    
+    // Walk the sections, remembering where each one starts
     while (file.good()) {
-        std::cout << "Attempting to parse level at line " << line_number << std::endl;
-        if (parseLevelFromFile(file, line_number, level_data)) {
-            level_count++;
-            // If level has no name, use level pack name + level number
-            if (level_data.name.empty()) {
-                level_data.name = level_pack_name + " - Level " + std::to_string(level_count);
-            }
-            std::cout << "Successfully parsed level " << level_count << ": " << level_data.name;
-            if (!level_data.description.empty()) {
-                std::cout << " - '" << level_data.description << "'";
-            }
-            if (!level_data.difficulty.empty()) {
-                std::cout << " (Difficulty: " << level_data.difficulty << ")";
-            }
-            std::cout << " (" << level_data.width << "x" << level_data.height << ")" << std::endl;
-            levels_.push_back(level_data);
-            // Don't increment line_number anymore - parseLevelFromFile handles file position now
-        } else {
-            std::cout << "No more levels found or error occurred" << std::endl;
+        std::streamoff section_offset = file.tellg();
+        if (!parseLevelFromFile(file, nullptr)) {
             break; // No more levels or error
         }
+        level_offsets_.push_back(section_offset);
     }
+    level_count_ = static_cast<int>(level_offsets_.size());
     
-    
-    file.close();
-    
-    if (levels_.empty()) {
+    if (level_count_ == 0) {
         std::cerr << "Error: No valid levels found in file: " << filepath << std::endl;
         return false;
     }
-    
-    // Load the first level
-    return loadLevelByIndex(0);
+    return true;
 }
 
-bool Level::parseLevelFromFile(std::ifstream& file, int startLineHint, LevelData& levelData) {
+bool Level::parseLevelFromFile(std::istream& file, LevelData* levelData) {
     // Reset the level data
-    levelData = LevelData();
-    levelData.width = 0;
-    levelData.height = 0;
-    levelData.warp_positions.clear();
-    
-    std::cout << "parseLevelFromFile: Starting at line " << startLineHint << std::endl;
+    if (levelData) {
+        *levelData = LevelData();
+        levelData->width = 0;
+        levelData->height = 0;
+    }
     
     std::string line;
-    int file_line_counter = 0; // To keep track of actual lines read from file for accurate seeking
-
-    // We're no longer using startLineHint to skip lines since we're tracking file position
-    // directly with tellg/seekg. The startLineHint parameter is kept for backward compatibility
-    // but we'll ignore it and just start parsing from the current file position.
-    std::cout << "Starting to parse from current file position" << std::endl;
-
-    // Process metadata and comments before the level grid
-    bool found_level_data = false;
     bool in_grid_data = false;
+    size_t grid_width = 0;
     
     while (true) {
         // Remember position before reading the line
@@ -171,9 +231,6 @@ bool Level::parseLevelFromFile(std::ifstream& file, int startLineHint, LevelData
             break; // End of file
         }
         
-        file_line_counter++;
-        
-        std::string original_line = line; // For seekg
         // Trim whitespace
         line.erase(0, line.find_first_not_of(" \t\n\r"));
         line.erase(line.find_last_not_of(" \t\n\r") + 1);
@@ -188,136 +245,181 @@ bool Level::parseLevelFromFile(std::ifstream& file, int startLineHint, LevelData
         
         // Process comments and metadata
         if (line[0] == ';') {
-            // If we were in grid data and now see a comment line, it's a new level section header
+            // If we were in grid data and now see a comment line, it's a new level section header.
+            // Rewind to the beginning of this line so the next call reads it.
             if (in_grid_data) {
-                 std::cout << "Found new section header while in grid data: '" << line << "'" << std::endl;
                  file.clear();
-                 // Rewind to the beginning of this line
                  file.seekg(line_pos);
-                 std::cout << "Rewinding file position to read this section in next call" << std::endl;
-                 std::cout << "Completed parsing level with " << levelData.layout.size() << " grid lines" << std::endl;
-                 return !levelData.layout.empty(); // Return true if we parsed something for the current level
+                 break;
+            }
+            if (!levelData) {
+                continue;
             }
 
             std::string metadata = line.substr(1);
             metadata.erase(0, metadata.find_first_not_of(" \t"));
             
             if (metadata.find("Name: ") == 0) {
-                levelData.name = metadata.substr(6);
-                std::cout << "Found level name: '" << levelData.name << "'" << std::endl;
+                levelData->name = metadata.substr(6);
             } else if (metadata.find("Description: ") == 0) {
-                levelData.description = metadata.substr(13);
-                std::cout << "Found level description: '" << levelData.description << "'" << std::endl;
+                levelData->description = metadata.substr(13);
             } else if (metadata.find("Author: ") == 0) {
-                levelData.author = metadata.substr(8);
-                std::cout << "Found level author: '" << levelData.author << "'" << std::endl;
+                levelData->author = metadata.substr(8);
             } else if (metadata.find("Difficulty: ") == 0) {
-                levelData.difficulty = metadata.substr(12);
-                std::cout << "Found level difficulty: '" << levelData.difficulty << "'" << std::endl;
-            } else {
-                 std::cout << "Found section header: '" << metadata << "'" << std::endl;
-                 // This is a section header (any comment line that isn't recognized metadata)
-                 // If we already have grid data for the *current* level, it means this is the start of the *next* level.
-                if (in_grid_data) {
-                    std::cout << "Already in grid data, treating this as a new level section" << std::endl;
-                    file.clear(); // Clear EOF flags if any
-                    // We need to rewind to the beginning of THIS section header line so the next call to parseLevelFromFile can process it.
-                    file.seekg(line_pos);
-                    break; // End parsing for the current level
-                } else {
-                    std::cout << "Not in grid data yet, using as level name: '" << metadata << "'" << std::endl;
-                    // If we haven't started grid data yet, use this as the level name if no explicit Name: tag is found
-                    if (levelData.name.empty()) {
-                        levelData.name = metadata;
-                    }
-                }
+                levelData->difficulty = metadata.substr(12);
+            } else if (levelData->name.empty()) {
+                // A section header before the grid names the level if no explicit Name: tag is found
+                levelData->name = metadata;
             }
             continue;
         }
         
         // If we reach here, we're processing the level grid data
-        found_level_data = true;
-        in_grid_data = true; // Mark that we are now in grid data mode
-        
-        // Add the line to the layout
-        levelData.layout.push_back(line);
-        
-        // Update width if needed
-        if (levelData.width == 0) {
-            levelData.width = line.length();
-        } else if (line.length() != levelData.width) {
-            std::cerr << "Error: Level has inconsistent line widths. Expected " << levelData.width << ", got " << line.length() << std::endl;
+        if (!in_grid_data) {
+            grid_width = line.length();
+            in_grid_data = true;
+        } else if (line.length() != grid_width) {
+            std::cerr << "Error: Level has inconsistent line widths. Expected " << grid_width
+                      << ", got " << line.length() << std::endl;
             return false;
         }
         
-        // Process the characters in the line
-        for (int c = 0; c < line.length(); ++c) {
+        // Add the line to the layout
+        if (levelData) {
+            levelData->layout.push_back(line);
+        }
+    }
+    
+    // Check if we found any level data
+    if (levelData) {
+        indexGridObjects(*levelData);
+    }
+    return in_grid_data && grid_width > 0;
+}
+
+bool Level::readLevel(int index, LevelData& level_data) const {
+    if (index < 0 || index >= level_count_) {
+        return false;
+    }
+    if (!generated_levels_.empty()) {
+        level_data = generated_levels_[index];
+        return true;
+    }
+    if (level_offsets_.empty()) {
+        return pack_cache_->readLevel(index, level_data);
+    }
+
+    std::ifstream file(filepath_);
+    if (!file.is_open()) {
+        std::cerr << "Error: Could not reopen level file: " << filepath_ << std::endl;
+        return false;
+    }
+    if (!parseLevelAt(file, level_offsets_[index], index, pack_name_, level_data)) {
+        std::cerr << "Error: Could not parse level " << (index + 1) << " of " << filepath_ << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool Level::parseLevelAt(std::istream& file, std::streamoff offset, int index,
+                         const std::string& pack_name, LevelData& level_data) {
+    file.clear(); // The previous level may have ended at EOF
+    if (!file.seekg(offset)) {
+        return false;
+    }
+    if (!parseLevelFromFile(file, &level_data)) {
+        return false;
+    }
+
+    // If level has no name, use level pack name + level number
+    if (level_data.name.empty()) {
+        level_data.name = pack_name + " - Level " + std::to_string(index + 1);
+    }
+    return true;
+}
+
+const LevelData* Level::getLevelData(int index) {
+    for (auto it = recent_levels_.begin(); it != recent_levels_.end(); ++it) {
+        if (it->first == index) {
+            recent_levels_.splice(recent_levels_.begin(), recent_levels_, it);
+            return &recent_levels_.front().second;
+        }
+    }
+
+    LevelData level_data;
+    if (!readLevel(index, level_data)) {
+        return nullptr;
+    }
+    recent_levels_.emplace_front(index, std::move(level_data));
+    if (recent_levels_.size() > RECENT_LEVELS_CAPACITY) {
+        recent_levels_.pop_back();
+    }
+    return &recent_levels_.front().second;
+}
+
+void Level::indexGridObjects(LevelData& level_data) {
+    level_data.height = level_data.layout.size();
+    level_data.width = level_data.layout.empty() ? 0 : level_data.layout[0].length();
+    level_data.ball_start_positions.clear();
+    level_data.crate_positions.clear();
+    level_data.hole_positions.clear();
+    level_data.reverse_item_positions.clear();
+    level_data.warp_positions.clear();
+
+    for (int row = 0; row < level_data.height; ++row) {
+        const std::string& line = level_data.layout[row];
+        for (int c = 0; c < static_cast<int>(line.length()); ++c) {
+            b2Vec2 position = {static_cast<float>(c), static_cast<float>(row)};
             switch (line[c]) {
-                case 'O': // Ball start position
-                    levelData.ball_start_position = {(float)c, (float)levelData.layout.size() - 1};
+                case 'O': // Ball start position, one per ball
+                    level_data.ball_start_positions.push_back(position);
+                    break;
+                case 'C': // Crate
+                    level_data.crate_positions.push_back(position);
                     break;
                 case 'G': // Goal
-                    levelData.goal_position = {(float)c, (float)levelData.layout.size() - 1};
+                    level_data.goal_position = position;
                     break;
                 case 'H': // Hole
-                    levelData.hole_positions.push_back({static_cast<float>(c), static_cast<float>(levelData.layout.size() - 1)});
+                    level_data.hole_positions.push_back(position);
                     break;
                 case 'R': // Reverse item
-                    levelData.reverse_item_positions.push_back({static_cast<float>(c), static_cast<float>(levelData.layout.size() - 1)});
+                    level_data.reverse_item_positions.push_back(position);
                     break;
-                case '1': // Warp (for now, only warp ID 1 is supported)
-                    levelData.warp_positions.push_back({1, {static_cast<float>(c), static_cast<float>(levelData.layout.size() - 1)}});
+                default:
+                    if (line[c] >= '1' && line[c] <= '9') { // Warp, paired with the other warp of the same digit
+                        level_data.warp_positions.push_back({line[c] - '0', position});
+                    }
                     break;
             }
         }
     }
-    
-    // Update height
-    levelData.height = levelData.layout.size();
-
-    // Check if we found any level data
-    if (!found_level_data || levelData.width == 0 || levelData.height == 0) {
-        return false;
-    }
-    
-    static int level_counter = 0;
-    std::cout << "Successfully parsed level " << ++level_counter << ": " << levelData.name;
-    if (!levelData.description.empty()) {
-        std::cout << " - '" << levelData.description << "'";
-    }
-    if (!levelData.difficulty.empty()) {
-        std::cout << " (Difficulty: " << levelData.difficulty << ")";
-    }
-    std::cout << " (" << levelData.width << "x" << levelData.height << ")" << std::endl;
-    return true;
 }
 
 bool Level::loadNextLevel() {
     if (hasMoreLevels()) {
-        current_level_index_++;
-        // This is the critical line that was missing. It copies the new level's data.
-        current_level_ = levels_[current_level_index_]; 
-        return true;
+        return loadLevelByIndex(current_level_index_ + 1);
     }
     return false;
 }
 
 const LevelData* Level::getCurrentLevelData() const {
-    if (current_level_index_ >= 0 && static_cast<size_t>(current_level_index_) < levels_.size()) {
-        return &levels_[current_level_index_];
+    if (current_level_index_ >= 0) {
+        return &current_level_;
     }
     return nullptr;
 }
 
 bool Level::loadLevelByIndex(int index) {
-    if (index < 0 || index >= levels_.size()) {
+    const LevelData* level_data = getLevelData(index);
+    if (!level_data) {
         return false;
     }
     
-    current_level_ = levels_[index];
+    current_level_ = *level_data;
     current_level_index_ = index;
     
-    std::cout << "Loaded level " << (index + 1) << "/" << levels_.size();
+    std::cout << "Loaded level " << (index + 1) << "/" << level_count_;
     if (!current_level_.name.empty()) {
         std::cout << ": " << current_level_.name;
     }
@@ -338,8 +440,12 @@ int Level::getHeight() const {
     return current_level_.height;
 }
 
-b2Vec2 Level::getBallStartPosition() const {
-    return current_level_.ball_start_position;
+const std::vector<b2Vec2>& Level::getBallStartPositions() const {
+    return current_level_.ball_start_positions;
+}
+
+const std::vector<b2Vec2>& Level::getCratePositions() const {
+    return current_level_.crate_positions;
 }
 
 b2Vec2 Level::getGoalPosition() const {
@@ -5,13 +5,18 @@
 #include <string>
 #include <map>
 #include <utility> // for std::pair
+#include <list>
+#include <memory>
+#include <future>
+#include <iosfwd>
 #include <box2d/box2d.h> // For b2Vec2
 
 struct LevelData {
     std::vector<std::string> layout;
     int width;
     int height;
-    b2Vec2 ball_start_position;
+    std::vector<b2Vec2> ball_start_positions; // One ball per 'O'
+    std::vector<b2Vec2> crate_positions;      // Pushable crates, 'C'
     b2Vec2 goal_position;
     std::vector<b2Vec2> hole_positions;
     std::vector<b2Vec2> reverse_item_positions;
@@ -22,18 +27,51 @@ struct LevelData {
     std::string difficulty;
 };
 
+// Structure to hold level pack metadata
+struct LevelPackInfo {
+    std::string filepath;
+    std::string name;
+    std::string description;
+    std::string author;
+    std::string date;
+};
+
+class LevelCache;
+
+// A level pack. Opening it only records where each level lives (byte offsets into the
+// .txt, or record offsets in the compiled pack); a level is parsed the first time it is
+// played and the last few are kept around.
 class Level {
 public:
     Level();
+    ~Level();
     bool loadFromFile(const std::string& filepath);
+    // A pack held in memory (generated levels), with no file behind it; getFilepath() is empty
+    bool loadFromLevels(const std::string& pack_name, std::vector<LevelData> levels);
+    void appendLevel(LevelData level_data); // Grows an in-memory pack, e.g. endless mode
+    // Opens a pack that was just edited, straight from its .txt: the sections are indexed
+    // again (their offsets may have moved) but only level `index` is parsed. The compiled
+    // pack is left alone, stale, so nothing else gets parsed; the next loadFromFile()
+    // rebuilds it. `index` is clamped to the levels the file still has.
+    bool reloadFromText(const std::string& filepath, int index);
+    // Writes levels in the .txt pack format read by loadFromFile
+    static bool saveToFile(const std::string& filepath, const LevelPackInfo& pack_info, const std::vector<LevelData>& levels);
     bool loadNextLevel(); // Load the next level in the file
     bool loadLevelByIndex(int index); // Load a specific level by index
+
+    // Parsed data of any level in the pack, through the recent-levels cache. The pointer
+    // is valid until RECENT_LEVELS_CAPACITY other levels have been requested.
+    const LevelData* getLevelData(int index);
+
+    // Fills width, height and the object positions of a level from its layout
+    static void indexGridObjects(LevelData& level_data);
     
     // Getters for the current level
     const std::vector<std::string>& getLayout() const;
     int getWidth() const;
     int getHeight() const;
-    b2Vec2 getBallStartPosition() const;
+    const std::vector<b2Vec2>& getBallStartPositions() const;
+    const std::vector<b2Vec2>& getCratePositions() const;
     b2Vec2 getGoalPosition() const;
     const std::vector<b2Vec2>& getHolePositions() const;
     const std::vector<b2Vec2>& getReverseItemPositions() const;
@@ -42,6 +80,7 @@ public:
     std::string getDescription() const;
     std::string getAuthor() const;
     std::string getDifficulty() const;
+    const std::string& getFilepath() const { return filepath_; }
     
     // Access the raw grid data
     const std::vector<std::string>& getGrid() const { return current_level_.layout; }
@@ -49,17 +88,41 @@ public:
     // Level management
     int getCurrentLevelIndex() const { return current_level_index_; }
     const LevelData* getCurrentLevelData() const;
-    int getTotalLevels() const { return levels_.size(); }
-    bool hasMoreLevels() const { return current_level_index_ < levels_.size() - 1; }
+    int getTotalLevels() const { return level_count_; }
+    bool hasMoreLevels() const { return current_level_index_ < level_count_ - 1; }
+
+    static constexpr size_t RECENT_LEVELS_CAPACITY = 4;
 
 private:
-    // Parse a single level from the file
-    bool parseLevelFromFile(std::ifstream& file, int startLineHint, LevelData& levelData);
+    // Record the byte offset of every level section of a .txt pack
+    bool scanTextFile(const std::string& filepath);
+
+    // Parse one level from the current file position. With levelData == nullptr the
+    // section is only skipped over (and checked), nothing is stored.
+    static bool parseLevelFromFile(std::istream& file, LevelData* levelData);
+
+    // Parse level `index` from the compiled pack or the .txt, bypassing recent_levels_
+    bool readLevel(int index, LevelData& level_data) const;
+
+    // Parse the level section at `offset` of an open .txt pack, naming it after the pack
+    // when it has no Name: tag
+    static bool parseLevelAt(std::istream& file, std::streamoff offset, int index,
+                             const std::string& pack_name, LevelData& level_data);
+
+    // Compile the .txt pack just indexed into the level cache on a worker thread, so only
+    // the first level is parsed before play starts. This Level keeps reading the .txt.
+    void compilePackInBackground();
     
-    std::vector<LevelData> levels_; // All levels from the file
+    int level_count_; // Levels in the pack
+    std::string pack_name_; // Used to name levels without a Name: tag
+    std::vector<std::streamoff> level_offsets_; // Start of each level section in the .txt
+    std::unique_ptr<LevelCache> pack_cache_; // Compiled pack, when it is up to date
+    std::vector<LevelData> generated_levels_; // Levels of an in-memory pack, see loadFromLevels
+    std::list<std::pair<int, LevelData>> recent_levels_; // Most recently used first
     LevelData current_level_; // Currently active level
     int current_level_index_; // Index of the current level
     std::string filepath_; // Store the filepath for reloading
+    std::future<void> pack_compile_; // Waited for before the next pack is loaded
 };
 
 #endif // LEVEL_H
@@ -0,0 +1,520 @@
+#include "LevelCache.h"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define LEVEL_CACHE_USE_MMAP 1
+#endif
+
+namespace fs = std::filesystem;
+
+namespace {
+
+// Cache files are only ever read back on the machine that wrote them, so integers are
+// stored in native byte order. Bump CACHE_VERSION whenever a layout changes.
+const char PACK_MAGIC[4] = {'B', 'M', 'L', 'P'};
+const char INDEX_MAGIC[4] = {'B', 'M', 'L', 'I'};
+const uint32_t CACHE_VERSION = 1;
+const size_t PACK_MTIME_OFFSET = 16;
+const size_t PACK_HEADER_SIZE = 40; // magic, version, source size, mtime, hash, level count, reserved
+
+// What the cache remembers about a source .txt
+struct SourceStamp {
+    uint64_t size = 0;
+    int64_t mtime = 0;
+    uint64_t hash = 0;
+};
+
+struct IndexEntry {
+    std::string filename;
+    SourceStamp stamp;
+    LevelPackInfo info;
+};
+
+class ByteWriter {
+public:
+    template <typename T>
+    void write(T value) {
+        bytes.append(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+    void writeString(const std::string& value) {
+        uint16_t length = static_cast<uint16_t>(std::min<size_t>(value.size(), UINT16_MAX));
+        write(length);
+        bytes.append(value.data(), length);
+    }
+    template <typename T>
+    void patch(size_t offset, T value) {
+        std::memcpy(&bytes[offset], &value, sizeof(T));
+    }
+
+    std::string bytes;
+};
+
+class ByteReader {
+public:
+    ByteReader(const unsigned char* data, size_t size, size_t offset = 0)
+        : data_(data), size_(size), offset_(offset) {}
+
+    template <typename T>
+    bool read(T& value) {
+        const unsigned char* bytes = take(sizeof(T));
+        if (!bytes) {
+            return false;
+        }
+        std::memcpy(&value, bytes, sizeof(T));
+        return true;
+    }
+    bool readString(std::string& value) {
+        uint16_t length = 0;
+        const unsigned char* bytes = read(length) ? take(length) : nullptr;
+        if (!bytes) {
+            return false;
+        }
+        value.assign(reinterpret_cast<const char*>(bytes), length);
+        return true;
+    }
+    const unsigned char* take(size_t count) {
+        if (offset_ > size_ || count > size_ - offset_) {
+            return nullptr;
+        }
+        const unsigned char* bytes = data_ + offset_;
+        offset_ += count;
+        return bytes;
+    }
+
+private:
+    const unsigned char* data_;
+    size_t size_;
+    size_t offset_;
+};
+
+bool statSource(const std::string& path, SourceStamp& stamp) {
+    std::error_code error;
+    stamp.size = fs::file_size(path, error);
+    if (error) {
+        return false;
+    }
+    auto write_time = fs::last_write_time(path, error);
+    if (error) {
+        return false;
+    }
+    stamp.mtime = static_cast<int64_t>(write_time.time_since_epoch().count());
+    return true;
+}
+
+bool hashSource(const std::string& path, SourceStamp& stamp) {
+    MappedFile source;
+    if (!source.open(path)) {
+        return false;
+    }
+    stamp.hash = LevelCache::hashBytes(source.data(), source.size());
+    return true;
+}
+
+fs::path cacheDirFor(const fs::path& levels_dir) {
+    return levels_dir / ".cache";
+}
+
+fs::path packCachePath(const std::string& pack_filepath) {
+    fs::path source(pack_filepath);
+    return cacheDirFor(source.parent_path()) / (source.stem().string() + ".bmlp");
+}
+
+// Writes to a temporary file and renames it over the target, so a crash never leaves a
+// half-written cache behind
+bool writeFileAtomically(const fs::path& path, const std::string& bytes) {
+    std::error_code error;
+    fs::create_directories(path.parent_path(), error);
+    if (error) {
+        return false;
+    }
+
+    fs::path temp_path = path;
+    temp_path += ".tmp";
+    {
+        std::ofstream file(temp_path, std::ios::binary | std::ios::trunc);
+        if (!file.write(bytes.data(), bytes.size())) {
+            return false;
+        }
+    }
+    fs::rename(temp_path, path, error);
+    return !error;
+}
+
+// Reads the pack metadata block at the top of a .txt pack (moved from Game::loadLevelPacks)
+LevelPackInfo parsePackInfo(const MappedFile& source) {
+    LevelPackInfo pack_info;
+    std::istringstream file(std::string(reinterpret_cast<const char*>(source.data()), source.size()));
+
+    // Read only the top metadata section (before any level sections)
+    bool in_pack_metadata = true;
+    bool found_empty_line = false;
+    std::string line;
+
+    while (in_pack_metadata && std::getline(file, line)) {
+        // Check for empty lines
+        if (line.empty()) {
+            // If we've already found pack metadata and now hit an empty line,
+            // this might be the separator before level sections
+            if (!pack_info.name.empty()) {
+                found_empty_line = true;
+            }
+            continue;
+        }
+
+        // If we found an empty line and now a non-empty line, check if it's a new section
+        if (found_empty_line && line[0] == ';') {
+            // This is likely the start of a level section
+            in_pack_metadata = false;
+            continue;
+        }
+
+        // Look for metadata in comment lines
+        if (line[0] == ';') {
+            std::string metadata = line.substr(1);
+            // Trim leading whitespace
+            metadata.erase(0, metadata.find_first_not_of(" \t"));
+
+            if (metadata.find("Name: ") == 0) {
+                pack_info.name = metadata.substr(6);
+            } else if (metadata.find("Description: ") == 0) {
+                pack_info.description = metadata.substr(13);
+            } else if (metadata.find("Author: ") == 0) {
+                pack_info.author = metadata.substr(8);
+            } else if (metadata.find("Date: ") == 0) {
+                pack_info.date = metadata.substr(6);
+            }
+        } else {
+            // Non-comment line - end of metadata
+            in_pack_metadata = false;
+        }
+    }
+    return pack_info;
+}
+
+std::map<std::string, IndexEntry> readIndex(const fs::path& index_path) {
+    std::map<std::string, IndexEntry> entries;
+    MappedFile file;
+    if (!file.open(index_path.string())) {
+        return entries;
+    }
+
+    ByteReader reader(file.data(), file.size());
+    const unsigned char* magic = reader.take(sizeof(INDEX_MAGIC));
+    uint32_t version = 0;
+    uint32_t count = 0;
+    if (!magic || std::memcmp(magic, INDEX_MAGIC, sizeof(INDEX_MAGIC)) != 0 ||
+        !reader.read(version) || version != CACHE_VERSION || !reader.read(count)) {
+        return entries;
+    }
+
+    for (uint32_t i = 0; i < count; ++i) {
+        IndexEntry entry;
+        if (!reader.readString(entry.filename) || !reader.read(entry.stamp.size) ||
+            !reader.read(entry.stamp.mtime) || !reader.read(entry.stamp.hash) ||
+            !reader.readString(entry.info.name) || !reader.readString(entry.info.description) ||
+            !reader.readString(entry.info.author) || !reader.readString(entry.info.date)) {
+            std::cerr << "Warning: Level pack index is truncated, rebuilding it" << std::endl;
+            entries.clear();
+            break;
+        }
+        entries[entry.filename] = entry;
+    }
+    return entries;
+}
+
+bool writeIndex(const fs::path& index_path, const std::vector<IndexEntry>& entries) {
+    ByteWriter writer;
+    writer.bytes.append(INDEX_MAGIC, sizeof(INDEX_MAGIC));
+    writer.write(CACHE_VERSION);
+    writer.write(static_cast<uint32_t>(entries.size()));
+    for (const auto& entry : entries) {
+        writer.writeString(entry.filename);
+        writer.write(entry.stamp.size);
+        writer.write(entry.stamp.mtime);
+        writer.write(entry.stamp.hash);
+        writer.writeString(entry.info.name);
+        writer.writeString(entry.info.description);
+        writer.writeString(entry.info.author);
+        writer.writeString(entry.info.date);
+    }
+    return writeFileAtomically(index_path, writer.bytes);
+}
+
+} // namespace
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+bool MappedFile::open(const std::string& path) {
+    close();
+
+#ifdef LEVEL_CACHE_USE_MMAP
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat file_stat;
+    if (fstat(fd, &file_stat) == 0 && file_stat.st_size > 0) {
+        void* mapping = mmap(nullptr, static_cast<size_t>(file_stat.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapping != MAP_FAILED) {
+            data_ = static_cast<const unsigned char*>(mapping);
+            size_ = static_cast<size_t>(file_stat.st_size);
+            mapped_ = true;
+        }
+    }
+    ::close(fd);
+    if (mapped_) {
+        return true;
+    }
+#endif
+
+    // No mmap (or an empty file): read it into memory instead
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+    buffer_.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    static const unsigned char empty = 0;
+    data_ = buffer_.empty() ? &empty : buffer_.data();
+    size_ = buffer_.size();
+    return true;
+}
+
+void MappedFile::close() {
+#ifdef LEVEL_CACHE_USE_MMAP
+    if (mapped_) {
+        munmap(const_cast<unsigned char*>(data_), size_);
+    }
+#endif
+    data_ = nullptr;
+    size_ = 0;
+    mapped_ = false;
+    buffer_.clear();
+}
+
+uint64_t LevelCache::hashBytes(const unsigned char* data, size_t size) {
+    uint64_t hash = 14695981039346656037ULL;
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= data[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+std::vector<LevelPackInfo> LevelCache::scanLevelPacks(const std::string& levels_dir) {
+    fs::path index_path = cacheDirFor(levels_dir) / "index.bin";
+    std::map<std::string, IndexEntry> cached = readIndex(index_path);
+
+    std::vector<IndexEntry> entries;
+    bool index_changed = false;
+    int packs_read = 0;
+    try {
+        for (const auto& dir_entry : fs::directory_iterator(levels_dir)) {
+            if (!dir_entry.is_regular_file() || dir_entry.path().extension() != ".txt") {
+                continue;
+            }
+
+            IndexEntry entry;
+            entry.filename = dir_entry.path().filename().string();
+            if (!statSource(dir_entry.path().string(), entry.stamp)) {
+                continue;
+            }
+
+            auto found = cached.find(entry.filename);
+            if (found != cached.end() && found->second.stamp.size == entry.stamp.size &&
+                found->second.stamp.mtime == entry.stamp.mtime) {
+                entries.push_back(found->second);
+                cached.erase(found);
+                continue;
+            }
+
+            // New or touched pack: only a content change needs the metadata re-read
+            MappedFile source;
+            if (!source.open(dir_entry.path().string())) {
+                continue;
+            }
+            entry.stamp.hash = hashBytes(source.data(), source.size());
+            if (found != cached.end() && found->second.stamp.hash == entry.stamp.hash) {
+                entry.info = found->second.info;
+            } else {
+                entry.info = parsePackInfo(source);
+                packs_read++;
+            }
+            if (found != cached.end()) {
+                cached.erase(found);
+            }
+            entries.push_back(entry);
+            index_changed = true;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error scanning level packs: " << e.what() << std::endl;
+    }
+
+    // Anything left in the old index was deleted or renamed
+    index_changed = index_changed || !cached.empty();
+
+    std::sort(entries.begin(), entries.end(),
+              [](const IndexEntry& a, const IndexEntry& b) { return a.filename < b.filename; });
+
+    if (index_changed && !writeIndex(index_path, entries)) {
+        std::cerr << "Warning: Could not write level pack index " << index_path.string() << std::endl;
+    }
+
+    std::vector<LevelPackInfo> packs;
+    for (auto& entry : entries) {
+        if (entry.info.name.empty()) {
+            continue; // Not a level pack
+        }
+        entry.info.filepath = (fs::path(levels_dir) / entry.filename).string();
+        packs.push_back(entry.info);
+    }
+
+    std::cout << "Level pack index: " << packs.size() << " packs, " << packs_read << " re-read" << std::endl;
+    return packs;
+}
+
+bool LevelCache::open(const std::string& pack_filepath) {
+    close();
+
+    SourceStamp source;
+    if (!statSource(pack_filepath, source)) {
+        return false;
+    }
+
+    fs::path cache_path = packCachePath(pack_filepath);
+    if (!file_.open(cache_path.string())) {
+        return false;
+    }
+
+    ByteReader reader(file_.data(), file_.size());
+    const unsigned char* magic = reader.take(sizeof(PACK_MAGIC));
+    uint32_t version = 0;
+    SourceStamp cached;
+    uint32_t level_count = 0;
+    uint32_t reserved = 0;
+    if (!magic || std::memcmp(magic, PACK_MAGIC, sizeof(PACK_MAGIC)) != 0 ||
+        !reader.read(version) || version != CACHE_VERSION ||
+        !reader.read(cached.size) || !reader.read(cached.mtime) || !reader.read(cached.hash) ||
+        !reader.read(level_count) || !reader.read(reserved) ||
+        file_.size() < PACK_HEADER_SIZE + static_cast<size_t>(level_count) * sizeof(uint32_t)) {
+        close();
+        return false;
+    }
+
+    if (cached.size != source.size || cached.mtime != source.mtime) {
+        if (cached.size != source.size || !hashSource(pack_filepath, source) || source.hash != cached.hash) {
+            close();
+            return false; // Contents changed
+        }
+
+        // Only the timestamp moved; record it so the next load skips the hash
+        std::fstream patch(cache_path, std::ios::binary | std::ios::in | std::ios::out);
+        if (patch.seekp(PACK_MTIME_OFFSET)) {
+            patch.write(reinterpret_cast<const char*>(&source.mtime), sizeof(source.mtime));
+        }
+    }
+
+    level_count_ = level_count;
+    return true;
+}
+
+void LevelCache::close() {
+    file_.close();
+    level_count_ = 0;
+}
+
+bool LevelCache::readLevel(int index, LevelData& level_data) const {
+    if (!file_.isOpen() || index < 0 || static_cast<uint32_t>(index) >= level_count_) {
+        return false;
+    }
+
+    uint32_t record_offset = 0;
+    ByteReader offsets(file_.data(), file_.size(), PACK_HEADER_SIZE + static_cast<size_t>(index) * sizeof(uint32_t));
+    if (!offsets.read(record_offset)) {
+        return false;
+    }
+
+    level_data = LevelData();
+    ByteReader reader(file_.data(), file_.size(), record_offset);
+    uint16_t width = 0;
+    uint16_t height = 0;
+    if (!reader.read(width) || !reader.read(height) ||
+        !reader.readString(level_data.name) || !reader.readString(level_data.description) ||
+        !reader.readString(level_data.author) || !reader.readString(level_data.difficulty)) {
+        return false;
+    }
+
+    const unsigned char* grid = reader.take(static_cast<size_t>(width) * height);
+    if (!grid || width == 0 || height == 0) {
+        return false;
+    }
+
+    level_data.layout.reserve(height);
+    for (int row = 0; row < height; ++row) {
+        level_data.layout.emplace_back(reinterpret_cast<const char*>(grid) + row * width, width);
+    }
+    Level::indexGridObjects(level_data);
+    return true;
+}
+
+bool LevelCache::writePack(const std::string& pack_filepath, int level_count,
+                           const std::function<bool(int, LevelData&)>& read_level) {
+    SourceStamp source;
+    if (level_count <= 0 || !statSource(pack_filepath, source) || !hashSource(pack_filepath, source)) {
+        return false;
+    }
+
+    ByteWriter writer;
+    writer.bytes.append(PACK_MAGIC, sizeof(PACK_MAGIC));
+    writer.write(CACHE_VERSION);
+    writer.write(source.size);
+    writer.write(source.mtime);
+    writer.write(source.hash);
+    writer.write(static_cast<uint32_t>(level_count));
+    writer.write(static_cast<uint32_t>(0)); // Reserved
+
+    size_t offset_table = writer.bytes.size();
+    writer.bytes.resize(offset_table + static_cast<size_t>(level_count) * sizeof(uint32_t));
+
+    LevelData level;
+    for (int i = 0; i < level_count; ++i) {
+        if (!read_level(i, level) || level.width <= 0 || level.height <= 0 || level.width > UINT16_MAX || level.height > UINT16_MAX) {
+            return false;
+        }
+
+        writer.patch(offset_table + i * sizeof(uint32_t), static_cast<uint32_t>(writer.bytes.size()));
+        writer.write(static_cast<uint16_t>(level.width));
+        writer.write(static_cast<uint16_t>(level.height));
+        writer.writeString(level.name);
+        writer.writeString(level.description);
+        writer.writeString(level.author);
+        writer.writeString(level.difficulty);
+        for (const auto& row : level.layout) {
+            writer.bytes.append(row, 0, level.width);
+        }
+    }
+
+    // An edit saved while the levels were parsed would pair the old stamp with new content
+    SourceStamp after;
+    if (!statSource(pack_filepath, after) || after.size != source.size || after.mtime != source.mtime) {
+        return false;
+    }
+
+    fs::path cache_path = packCachePath(pack_filepath);
+    if (!writeFileAtomically(cache_path, writer.bytes)) {
+        std::cerr << "Warning: Could not write level cache " << cache_path.string() << std::endl;
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,69 @@
+#ifndef LEVEL_CACHE_H
+#define LEVEL_CACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+#include "Level.h"
+
+// Read-only view of a whole file. Uses mmap where available and falls back to reading
+// the file into memory.
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const { return data_ != nullptr; }
+    const unsigned char* data() const { return data_; }
+    size_t size() const { return size_; }
+
+private:
+    const unsigned char* data_ = nullptr;
+    size_t size_ = 0;
+    bool mapped_ = false;
+    std::vector<unsigned char> buffer_; // Used when mmap isn't available
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+};
+
+// Compiled level packs, stored next to the .txt packs in <levels dir>/.cache/.
+//
+// index.bin holds the metadata of every pack in the directory, so the start screen needs a
+// single file read no matter how many packs there are. Each pack also gets a binary file
+// with its levels already parsed: a fixed header, a table of record offsets and one record
+// per level (name, description, author, difficulty and the raw grid). Both are validated
+// against the source .txt by size and mtime first, then by an FNV-1a hash of its contents,
+// so touching a file without changing it doesn't force a rebuild.
+class LevelCache {
+public:
+    // Metadata for every .txt pack in levels_dir, using the index for unchanged packs and
+    // re-reading only the ones that changed. Packs without a name are skipped.
+    static std::vector<LevelPackInfo> scanLevelPacks(const std::string& levels_dir);
+
+    // Maps the compiled form of a pack. Returns false if it is missing or stale, in which
+    // case the caller indexes the .txt and calls writePack().
+    bool open(const std::string& pack_filepath);
+    void close();
+    int getLevelCount() const { return static_cast<int>(level_count_); }
+    bool readLevel(int index, LevelData& level_data) const; // Decodes one level record
+
+    // Compiles a pack. Levels are requested one at a time through read_level and serialized
+    // into a buffer as they come, so only one parsed level is alive at a time; the encoded
+    // pack (about the size of the .txt) is held until it is written out. Level calls this
+    // from a worker thread after the first level is loaded.
+    static bool writePack(const std::string& pack_filepath, int level_count,
+                          const std::function<bool(int, LevelData&)>& read_level);
+
+    static uint64_t hashBytes(const unsigned char* data, size_t size); // FNV-1a, 64 bit
+
+private:
+    MappedFile file_;
+    uint32_t level_count_ = 0;
+};
+
+#endif // LEVEL_CACHE_H
@@ -0,0 +1,87 @@
+#include "LevelWatcher.h"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+#ifdef __linux__
+#include <cerrno>
+#include <sys/inotify.h>
+#include <unistd.h>
+#define LEVEL_WATCHER_USE_INOTIFY 1
+#endif
+
+LevelWatcher::~LevelWatcher() {
+    stop();
+}
+
+bool LevelWatcher::start(const std::string& levels_dir) {
+    stop();
+    levels_dir_ = levels_dir;
+#ifdef LEVEL_WATCHER_USE_INOTIFY
+    inotify_fd_ = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (inotify_fd_ < 0) {
+        std::cerr << "Warning: Level hot-reload disabled, inotify_init1 failed: " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    watch_descriptor_ = inotify_add_watch(inotify_fd_, levels_dir.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO);
+    if (watch_descriptor_ < 0) {
+        std::cerr << "Warning: Level hot-reload disabled, cannot watch " << levels_dir << ": " << std::strerror(errno) << std::endl;
+        stop();
+        return false;
+    }
+    std::cout << "Watching " << levels_dir << " for level edits" << std::endl;
+    return true;
+#else
+    std::cout << "Level hot-reload needs inotify; not available on this platform" << std::endl;
+    return false;
+#endif
+}
+
+void LevelWatcher::stop() {
+#ifdef LEVEL_WATCHER_USE_INOTIFY
+    if (inotify_fd_ >= 0) {
+        close(inotify_fd_); // Also removes the watch
+    }
+#endif
+    inotify_fd_ = -1;
+    watch_descriptor_ = -1;
+}
+
+std::vector<std::string> LevelWatcher::poll() {
+    std::vector<std::string> changed;
+#ifdef LEVEL_WATCHER_USE_INOTIFY
+    if (inotify_fd_ < 0) {
+        return changed;
+    }
+
+    // Aligned as the kernel expects; one read returns as many whole events as fit
+    alignas(struct inotify_event) char buffer[4096];
+    for (;;) {
+        ssize_t length = read(inotify_fd_, buffer, sizeof(buffer));
+        if (length <= 0) {
+            break; // EAGAIN: nothing more queued
+        }
+        for (char* position = buffer; position < buffer + length;) {
+            const struct inotify_event* event = reinterpret_cast<const struct inotify_event*>(position);
+            position += sizeof(struct inotify_event) + event->len;
+
+            if (event->mask & IN_Q_OVERFLOW) {
+                std::cerr << "Warning: Level watcher missed events (queue overflow)" << std::endl;
+                continue;
+            }
+            if (event->len == 0 || (event->mask & IN_ISDIR)) {
+                continue;
+            }
+            std::string name = event->name;
+            if (name.size() < 4 || name.compare(name.size() - 4, 4, ".txt") != 0) {
+                continue; // Editor swap and backup files
+            }
+            std::string path = levels_dir_ + "/" + name;
+            if (std::find(changed.begin(), changed.end(), path) == changed.end()) {
+                changed.push_back(path);
+            }
+        }
+    }
+#endif
+    return changed;
+}
@@ -0,0 +1,34 @@
+#ifndef LEVEL_WATCHER_H
+#define LEVEL_WATCHER_H
+
+#include <string>
+#include <vector>
+
+// Reports level packs (.txt) in a directory that were written or replaced since the last
+// poll, using a non-blocking inotify descriptor. Both ways editors save are seen: writing
+// the file in place (IN_CLOSE_WRITE) and renaming a temporary over it (IN_MOVED_TO).
+// Only the directory itself is watched, so the compiled packs in .cache/ don't show up.
+// Without inotify (anything but Linux) start() returns false and poll() finds nothing.
+class LevelWatcher {
+public:
+    LevelWatcher() = default;
+    ~LevelWatcher();
+
+    bool start(const std::string& levels_dir);
+    void stop();
+    bool isWatching() const { return inotify_fd_ >= 0; }
+
+    // Paths (levels_dir/name) of the packs changed since the last call, each listed once.
+    // Never blocks, so it can run every frame.
+    std::vector<std::string> poll();
+
+private:
+    std::string levels_dir_;
+    int inotify_fd_ = -1;
+    int watch_descriptor_ = -1;
+
+    LevelWatcher(const LevelWatcher&) = delete;
+    LevelWatcher& operator=(const LevelWatcher&) = delete;
+};
+
+#endif // LEVEL_WATCHER_H
@@ -1,11 +1,21 @@
 #include "Maze.h"
 #include <cmath> // For M_PI, cos, sin
 #include <iostream>
+#include <algorithm> // For std::max
+#include <limits>
 
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
 #endif
 
+// Side of a physics chunk. Big enough that a ball touches only a few at once, small enough
+// that the walls across a large maze stay out of the broadphase.
+static const int PHYSICS_CHUNK_TILES = 16;
+// Chunks are enabled this far ahead of what a body can reach and only disabled once it is
+// further away than CHUNK_DISABLE_MARGIN_TILES, so a ball on a border doesn't toggle them
+static const float CHUNK_ENABLE_MARGIN_TILES = 2.0f;
+static const float CHUNK_DISABLE_MARGIN_TILES = 4.0f;
+
 Maze::Maze(b2WorldId worldId) : 
     worldId_(worldId), 
     maze_body_id_(b2_nullBodyId),
@@ -15,23 +25,36 @@ Maze::Maze(b2WorldId worldId) :
     tile_size_meters_(0.0f)
 {
     maze_center_world_coords_ = {0.0f, 0.0f};
+    maze_origin_world_coords_ = {0.0f, 0.0f};
+    goal_offset_meters_ = {0.0f, 0.0f};
+    maze_size_meters_ = {0.0f, 0.0f};
 }
 
 Maze::~Maze() {
-    if (b2Body_IsValid(maze_body_id_)) { // Destroy the single maze body
-        b2DestroyBody(maze_body_id_);
-        maze_body_id_ = b2_nullBodyId;
-    }
+    destroyBodies();
     wall_segments_.clear(); // Clear the visual segment data
+    releaseRenderCache();
 }
 
-void Maze::create(const Level& level, b2Vec2 maze_world_origin_meters) {
-    // --- Cleanup and Reset ---
+void Maze::destroyBodies() {
+    for (const WallChunk& chunk : wall_chunks_) {
+        if (b2Body_IsValid(chunk.body_id)) {
+            b2DestroyBody(chunk.body_id);
+        }
+    }
+    wall_chunks_.clear();
     if (b2Body_IsValid(maze_body_id_)) {
         b2DestroyBody(maze_body_id_);
         maze_body_id_ = b2_nullBodyId;
     }
+}
+
+void Maze::create(const Level& level, b2Vec2 maze_world_origin_meters) {
+    // --- Cleanup and Reset ---
+    destroyBodies();
     wall_segments_.clear();
+    hole_offsets_meters_.clear();
+    releaseRenderCache();
 
     // Explicitly reset all rotation variables to their default states
     current_rotation_rad_ = 0.0f;
@@ -49,61 +72,134 @@ void Maze::create(const Level& level, b2Vec2 maze_world_origin_meters) {
         maze_world_origin_meters.x + maze_pixel_width_meters / 2.0f,
         maze_world_origin_meters.y + maze_pixel_height_meters / 2.0f
     };
+    maze_origin_world_coords_ = maze_world_origin_meters;
+    maze_size_meters_ = {maze_pixel_width_meters, maze_pixel_height_meters};
+
+    // Holes and the goal are drawn with the maze, so keep them in the maze body frame
+    for (const auto& hole_position : level.getHolePositions()) {
+        hole_offsets_meters_.push_back(gridToLocal(hole_position));
+    }
+    if (const LevelData* level_data = level.getCurrentLevelData()) {
+        goal_offset_meters_ = gridToLocal(level_data->goal_position);
+    }
 
-    // Create the single kinematic body for the entire maze
+    // Create the main kinematic body of the maze. It carries the sensors and the outer
+    // boundary; the walls go on chunk bodies below that follow its transform.
     // Changed from static to kinematic to enable continuous rotation via angular velocity
     b2BodyDef maze_body_def = b2DefaultBodyDef();
     maze_body_def.type = b2_kinematicBody;
     maze_body_def.position = this->maze_center_world_coords_; // Position the body at its pivot
+    maze_body_def.enableSleep = false; // Holes, goal and items are sensors on this body; keep them reporting
     maze_body_id_ = b2CreateBody(worldId_, &maze_body_def);
 
     if (!b2Body_IsValid(maze_body_id_)) {
         std::cerr << "Error: Failed to create the main maze body!" << std::endl;
         return;
     }
+    savePreviousTransform();
+
+    // Merge runs of '#' into rectangles first. One shape per tile made big mazes carry
+    // thousands of shapes, all of which get their AABBs refit every step while rotating.
+    std::vector<WallRect> wall_rects = mergeWallTiles(layout);
+
+    b2ShapeDef wall_fixture_def = b2DefaultShapeDef();
+    wall_fixture_def.density = 0.0f; // Static bodies have 0 density/mass
+    wall_fixture_def.material.friction = 0.5f;
+    wall_fixture_def.material.restitution = 0.0f;  // No bounciness
+
+    // Chunk bodies start disabled, out of the broadphase; updateActiveChunks brings in
+    // the ones near the balls before the first step
+    int walls_width = grid_width; // Rows aren't guaranteed to be as long as the first one
+    for (const auto& rect : wall_rects) {
+        walls_width = std::max(walls_width, rect.col + rect.width);
+    }
+    int chunks_across = (walls_width + PHYSICS_CHUNK_TILES - 1) / PHYSICS_CHUNK_TILES;
+    int chunks_down = (grid_height + PHYSICS_CHUNK_TILES - 1) / PHYSICS_CHUNK_TILES;
+    std::vector<int> chunk_at(static_cast<size_t>(chunks_across) * chunks_down, -1);
+    b2BodyDef chunk_body_def = maze_body_def;
+    chunk_body_def.isEnabled = false;
+    chunk_body_def.enableSleep = true; // Nothing on the chunks needs to report while the maze is still
+
+    // Offset of a block of tiles' center from the maze's central pivot point
+    auto offset_from_pivot = [&](int col, int row, int width, int height) {
+        b2Vec2 center_world_meters = {
+            maze_world_origin_meters.x + (col + width * 0.5f) * tile_size_meters_,
+            maze_world_origin_meters.y + (row + height * 0.5f) * tile_size_meters_
+        };
+        return center_world_meters - this->maze_center_world_coords_;
+    };
 
-    for (int r = 0; r < grid_height; ++r) {
-        for (int c = 0; c < grid_width; ++c) {
-            if (layout[r][c] == '#') {
-                // Calculate the center of this wall segment in world coordinates
-                b2Vec2 initial_wall_center_world_meters = {
-                    maze_world_origin_meters.x + (c + 0.5f) * tile_size_meters_,
-                    maze_world_origin_meters.y + (r + 0.5f) * tile_size_meters_
-                };
-                
-                // Calculate the offset of this wall segment from the maze's central pivot point
-                b2Vec2 offset_from_pivot = initial_wall_center_world_meters - this->maze_center_world_coords_;
+    int wall_tile_count = 0;
+    int wall_shape_count = 0;
+    for (const auto& rect : wall_rects) {
+        wall_tile_count += rect.width * rect.height;
+
+        WallSegment segment;
+        segment.original_offset_from_center_meters = offset_from_pivot(rect.col, rect.row, rect.width, rect.height);
+        segment.size_meters = {rect.width * tile_size_meters_, rect.height * tile_size_meters_};
+        wall_segments_.push_back(segment);
+
+        // Physics shapes are cut at chunk borders, so a long merged run doesn't stretch one
+        // chunk across the maze. The pieces overlap like any other neighbouring walls.
+        for (int row = rect.row; row < rect.row + rect.height; row = (row / PHYSICS_CHUNK_TILES + 1) * PHYSICS_CHUNK_TILES) {
+            int piece_bottom = std::min(rect.row + rect.height, (row / PHYSICS_CHUNK_TILES + 1) * PHYSICS_CHUNK_TILES);
+            for (int col = rect.col; col < rect.col + rect.width; col = (col / PHYSICS_CHUNK_TILES + 1) * PHYSICS_CHUNK_TILES) {
+                int piece_right = std::min(rect.col + rect.width, (col / PHYSICS_CHUNK_TILES + 1) * PHYSICS_CHUNK_TILES);
+                int piece_width = piece_right - col;
+                int piece_height = piece_bottom - row;
+
+                size_t chunk_cell = static_cast<size_t>(row / PHYSICS_CHUNK_TILES) * chunks_across + col / PHYSICS_CHUNK_TILES;
+                if (chunk_at[chunk_cell] < 0) {
+                    WallChunk chunk;
+                    chunk.body_id = b2CreateBody(worldId_, &chunk_body_def);
+                    chunk.bounds = {{std::numeric_limits<float>::max(), std::numeric_limits<float>::max()},
+                                    {std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest()}};
+                    chunk.enabled = false;
+                    chunk_at[chunk_cell] = static_cast<int>(wall_chunks_.size());
+                    wall_chunks_.push_back(chunk);
+                }
+                WallChunk& chunk = wall_chunks_[chunk_at[chunk_cell]];
 
-                // Create the shape (box) for this wall segment
                 // Add overlap to physics shape dimensions
-                float physics_hx = (tile_size_meters_ / 2.0f) + PHYSICS_SHAPE_OVERLAP_METERS;
-                float physics_hy = (tile_size_meters_ / 2.0f) + PHYSICS_SHAPE_OVERLAP_METERS;
-
-                // 1. Create a base polygon centered at (0,0)
-                b2Polygon wall_polygon = b2MakeBox(physics_hx, physics_hy);
-
-                // 2. Define the local transform for this segment
-                b2Transform local_transform = b2Transform_identity; // Correct way to get identity transform
-                local_transform.p = offset_from_pivot; // Apply the translation
-                // local_transform.q remains identity (no local rotation of the shape itself)
-
-                // 3. Apply the local transform to the polygon's vertices and get the new polygon
-                wall_polygon = b2TransformPolygon(local_transform, &wall_polygon); // Correct usage
-                
-                b2ShapeDef wall_fixture_def = b2DefaultShapeDef();
-                wall_fixture_def.density = 0.0f; // Static bodies have 0 density/mass
-                wall_fixture_def.material.friction = 0.5f;
-                wall_fixture_def.material.restitution = 0.0f;  // No bounciness
-                // Add this shape to the single maze body
-                b2CreatePolygonShape(maze_body_id_, &wall_fixture_def, &wall_polygon);
-
-                WallSegment segment; // Use WallSegment as per Maze.h
-                segment.original_offset_from_center_meters = offset_from_pivot;
-                segment.size_meters = {tile_size_meters_, tile_size_meters_};
-                wall_segments_.push_back(segment);
+                b2Vec2 piece_offset = offset_from_pivot(col, row, piece_width, piece_height);
+                b2Vec2 physics_half_size = {
+                    (piece_width * tile_size_meters_ / 2.0f) + PHYSICS_SHAPE_OVERLAP_METERS,
+                    (piece_height * tile_size_meters_ / 2.0f) + PHYSICS_SHAPE_OVERLAP_METERS
+                };
+
+                // Base box centered at (0,0), then moved to the piece's offset in the maze body frame
+                b2Polygon wall_polygon = b2MakeBox(physics_half_size.x, physics_half_size.y);
+                b2Transform local_transform = b2Transform_identity;
+                local_transform.p = piece_offset;
+                wall_polygon = b2TransformPolygon(local_transform, &wall_polygon);
+                b2CreatePolygonShape(chunk.body_id, &wall_fixture_def, &wall_polygon);
+                wall_shape_count++;
+
+                chunk.bounds.lowerBound = b2Min(chunk.bounds.lowerBound, b2Sub(piece_offset, physics_half_size));
+                chunk.bounds.upperBound = b2Max(chunk.bounds.upperBound, b2Add(piece_offset, physics_half_size));
             }
         }
     }
+
+    std::cout << "Maze walls: " << wall_tile_count << " tiles merged into "
+              << wall_rects.size() << " rectangles, " << wall_shape_count << " shapes on "
+              << wall_chunks_.size() << " chunk bodies" << std::endl;
+
+    // Index what the maze draws, so render() only visits what is on screen
+    b2Vec2 half_maze = {maze_pixel_width_meters / 2.0f, maze_pixel_height_meters / 2.0f};
+    b2AABB maze_bounds = {b2Neg(half_maze), half_maze};
+    wall_grid_.reset(maze_bounds, GRID_CELL_TILES * tile_size_meters_);
+    hole_grid_.reset(maze_bounds, GRID_CELL_TILES * tile_size_meters_);
+    for (size_t i = 0; i < wall_segments_.size(); ++i) {
+        b2Vec2 half_size = b2MulSV(0.5f, wall_segments_[i].size_meters);
+        b2Vec2 center = wall_segments_[i].original_offset_from_center_meters;
+        wall_grid_.insert(static_cast<int>(i), {b2Sub(center, half_size), b2Add(center, half_size)});
+    }
+    b2Vec2 hole_half_size = {tile_size_meters_ / 2.0f, tile_size_meters_ / 2.0f};
+    for (size_t i = 0; i < hole_offsets_meters_.size(); ++i) {
+        hole_grid_.insert(static_cast<int>(i), {b2Sub(hole_offsets_meters_[i], hole_half_size), b2Add(hole_offsets_meters_[i], hole_half_size)});
+    }
+
     // No need to call applyCurrentRotationToBodies() here, 
     // the body is created with 0 rotation at its center.
 
@@ -157,17 +253,215 @@ void Maze::create(const Level& level, b2Vec2 maze_world_origin_meters) {
     b2CreatePolygonShape(maze_body_id_, &right_wall_def, &right_wall);
 }
 
-void Maze::render(SDL_Renderer* renderer, float camera_offset_x, float camera_offset_y) const {
+b2Vec2 Maze::gridToLocal(b2Vec2 grid_position) const {
+    b2Vec2 tile_center_world = {
+        maze_origin_world_coords_.x + (grid_position.x + 0.5f) * tile_size_meters_,
+        maze_origin_world_coords_.y + (grid_position.y + 0.5f) * tile_size_meters_
+    };
+    return tile_center_world - maze_center_world_coords_;
+}
+
+b2ShapeId Maze::addSensor(b2Vec2 local_position, float radius, void* user_data) {
     if (!b2Body_IsValid(maze_body_id_)) {
-        return; // Nothing to render if the main maze body isn't valid
+        return b2_nullShapeId;
     }
 
-    SDL_SetRenderDrawColor(renderer, 100, 100, 100, 255); // Grey walls
+    b2Circle circle;
+    circle.center = local_position;
+    circle.radius = radius;
+
+    b2ShapeDef sensor_def = b2DefaultShapeDef();
+    sensor_def.isSensor = true;
+    sensor_def.enableSensorEvents = true;
+    sensor_def.userData = user_data;
+    return b2CreateCircleShape(maze_body_id_, &sensor_def, &circle);
+}
+
+void Maze::updateActiveChunks(const std::vector<b2BodyId>& bodies, float lookahead_seconds) {
+    if (wall_chunks_.empty() || !b2Body_IsValid(maze_body_id_)) {
+        return;
+    }
+    b2Transform maze_transform = b2Body_GetTransform(maze_body_id_);
+    float maze_angular_velocity = b2Body_GetAngularVelocity(maze_body_id_);
+
+    chunk_probes_.clear();
+    for (b2BodyId body_id : bodies) {
+        if (!b2Body_IsValid(body_id) || !b2Body_IsEnabled(body_id)) {
+            continue; // Balls in a hole or the goal are out of the simulation
+        }
+        b2AABB box = b2Body_ComputeAABB(body_id);
+        b2Vec2 center = b2MulSV(0.5f, b2Add(box.lowerBound, box.upperBound));
+        float extent = b2Length(b2MulSV(0.5f, b2Sub(box.upperBound, box.lowerBound)));
+        // Speed against the walls, which sweep past at angular velocity times the distance to the pivot
+        b2Vec2 wall_velocity = b2CrossSV(maze_angular_velocity, b2Sub(center, maze_transform.p));
+        float relative_speed = b2Length(b2Sub(b2Body_GetLinearVelocity(body_id), wall_velocity));
+        chunk_probes_.push_back({b2InvTransformPoint(maze_transform, center), extent + relative_speed * lookahead_seconds});
+    }
+
+    for (WallChunk& chunk : wall_chunks_) {
+        float margin = (chunk.enabled ? CHUNK_DISABLE_MARGIN_TILES : CHUNK_ENABLE_MARGIN_TILES) * tile_size_meters_;
+        bool in_reach = false;
+        for (const ChunkProbe& probe : chunk_probes_) {
+            // Distance from the probe to the chunk bounds, zero inside them
+            float dx = std::max({chunk.bounds.lowerBound.x - probe.local_position.x, 0.0f, probe.local_position.x - chunk.bounds.upperBound.x});
+            float dy = std::max({chunk.bounds.lowerBound.y - probe.local_position.y, 0.0f, probe.local_position.y - chunk.bounds.upperBound.y});
+            float range = probe.reach + margin;
+            if (dx * dx + dy * dy <= range * range) {
+                in_reach = true;
+                break;
+            }
+        }
+
+        if (in_reach && !chunk.enabled) {
+            // A disabled body doesn't move, so catch it up with the maze before it collides
+            b2Body_Enable(chunk.body_id);
+            b2Body_SetTransform(chunk.body_id, maze_transform.p, maze_transform.q);
+            b2Body_SetAngularVelocity(chunk.body_id, maze_angular_velocity);
+            chunk.enabled = true;
+        } else if (!in_reach && chunk.enabled) {
+            b2Body_Disable(chunk.body_id);
+            chunk.enabled = false;
+        }
+    }
+}
+
+int Maze::getEnabledChunkCount() const {
+    int enabled = 0;
+    for (const WallChunk& chunk : wall_chunks_) {
+        enabled += chunk.enabled ? 1 : 0;
+    }
+    return enabled;
+}
 
-    // Get the current transform of the entire maze body
-    b2Transform maze_body_transform = b2Body_GetTransform(maze_body_id_);
+bool Maze::buildRenderCache(SDL_Renderer* renderer) {
+    releaseRenderCache();
+    if (!renderer || wall_segments_.empty() || !SDL_RenderTargetSupported(renderer)) {
+        return false;
+    }
 
+    int texture_width = static_cast<int>(ceilf(maze_size_meters_.x * PPM));
+    int texture_height = static_cast<int>(ceilf(maze_size_meters_.y * PPM));
+    SDL_RendererInfo info;
+    if (SDL_GetRendererInfo(renderer, &info) == 0 && info.max_texture_width > 0 &&
+        (texture_width > info.max_texture_width || texture_height > info.max_texture_height)) {
+        std::cout << "Maze is " << texture_width << "x" << texture_height << " px, larger than the renderer's "
+                  << info.max_texture_width << "x" << info.max_texture_height
+                  << " texture limit; drawing it per frame" << std::endl;
+        return false;
+    }
+
+    static_texture_ = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET,
+                                        texture_width, texture_height);
+    if (!static_texture_) {
+        std::cerr << "Warning: Could not create maze texture: " << SDL_GetError() << std::endl;
+        return false;
+    }
+    SDL_SetTextureBlendMode(static_texture_, SDL_BLENDMODE_BLEND);
+
+    SDL_Texture* previous_target = SDL_GetRenderTarget(renderer);
+    SDL_SetRenderTarget(renderer, static_texture_);
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0); // Transparent outside the walls
+    SDL_RenderClear(renderer);
+
+    // Texture pixel (0,0) is the maze's top-left corner at 0 rotation
+    auto to_texture = [&](b2Vec2 offset_from_center) {
+        return SDL_Point{
+            static_cast<int>((offset_from_center.x + maze_size_meters_.x / 2.0f) * PPM),
+            static_cast<int>((offset_from_center.y + maze_size_meters_.y / 2.0f) * PPM)
+        };
+    };
+
+    SDL_SetRenderDrawColor(renderer, 100, 100, 100, 255); // Grey walls
     for (const auto& segment : wall_segments_) {
+        b2Vec2 half_size = {segment.size_meters.x / 2.0f, segment.size_meters.y / 2.0f};
+        SDL_Point top_left = to_texture(segment.original_offset_from_center_meters - half_size);
+        SDL_Point bottom_right = to_texture(segment.original_offset_from_center_meters + half_size);
+        SDL_Rect outline = {top_left.x, top_left.y, bottom_right.x - top_left.x, bottom_right.y - top_left.y};
+        SDL_RenderDrawRect(renderer, &outline);
+    }
+
+    BatchRenderer batch;
+    SDL_Point goal = to_texture(goal_offset_meters_);
+    batch.fillCircle(goal.x, goal.y, TILE_SIZE / 2.0f, {0, 255, 0, 255}); // Green for the goal
+    for (const auto& hole_offset : hole_offsets_meters_) {
+        SDL_Point hole = to_texture(hole_offset);
+        batch.fillCircle(hole.x, hole.y, (TILE_SIZE / 2.0f) * 0.9f, {0, 0, 0, 255}); // Black holes
+    }
+    batch.flush(renderer);
+
+    SDL_SetRenderTarget(renderer, previous_target);
+    return true;
+}
+
+void Maze::releaseRenderCache() {
+    if (static_texture_) {
+        SDL_DestroyTexture(static_texture_);
+        static_texture_ = nullptr;
+    }
+}
+
+b2AABB Maze::getVisibleLocalBounds(const b2Transform& maze_body_transform, float camera_offset_x, float camera_offset_y) const {
+    // Screen corners to world meters, then into the (rotated) maze body frame
+    const b2Vec2 screen_corners[4] = {
+        {0.0f, 0.0f}, {static_cast<float>(SCREEN_WIDTH), 0.0f},
+        {0.0f, static_cast<float>(SCREEN_HEIGHT)}, {static_cast<float>(SCREEN_WIDTH), static_cast<float>(SCREEN_HEIGHT)}
+    };
+    b2AABB bounds = {{std::numeric_limits<float>::max(), std::numeric_limits<float>::max()},
+                     {std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest()}};
+    for (const b2Vec2& corner : screen_corners) {
+        b2Vec2 world = {(corner.x - camera_offset_x) / PPM, (corner.y - camera_offset_y) / PPM};
+        b2Vec2 local = b2InvTransformPoint(maze_body_transform, world);
+        bounds.lowerBound = b2Min(bounds.lowerBound, local);
+        bounds.upperBound = b2Max(bounds.upperBound, local);
+    }
+    return bounds;
+}
+
+void Maze::render(SDL_Renderer* renderer, BatchRenderer& batch, float camera_offset_x, float camera_offset_y, float alpha) const {
+    if (!b2Body_IsValid(maze_body_id_)) {
+        return; // Nothing to render if the main maze body isn't valid
+    }
+
+    b2Transform maze_body_transform = getInterpolatedTransform(alpha);
+    b2AABB visible = getVisibleLocalBounds(maze_body_transform, camera_offset_x, camera_offset_y);
+    if (!static_texture_) {
+        renderUncached(batch, maze_body_transform, visible, camera_offset_x, camera_offset_y);
+        return;
+    }
+
+    // Copy only the part of the texture under the screen. Texture pixel (0,0) is the maze's
+    // top-left corner; the body sits at the maze center, which SDL rotates the copy about.
+    int texture_width = static_cast<int>(ceilf(maze_size_meters_.x * PPM));
+    int texture_height = static_cast<int>(ceilf(maze_size_meters_.y * PPM));
+    int left = std::max(0, static_cast<int>(floorf((visible.lowerBound.x + maze_size_meters_.x / 2.0f) * PPM)));
+    int top = std::max(0, static_cast<int>(floorf((visible.lowerBound.y + maze_size_meters_.y / 2.0f) * PPM)));
+    int right = std::min(texture_width, static_cast<int>(ceilf((visible.upperBound.x + maze_size_meters_.x / 2.0f) * PPM)));
+    int bottom = std::min(texture_height, static_cast<int>(ceilf((visible.upperBound.y + maze_size_meters_.y / 2.0f) * PPM)));
+    if (left >= right || top >= bottom) {
+        return; // Maze entirely off screen
+    }
+
+    SDL_Rect source = {left, top, right - left, bottom - top};
+    SDL_FRect destination = {
+        (maze_body_transform.p.x - maze_size_meters_.x / 2.0f) * PPM + left + camera_offset_x,
+        (maze_body_transform.p.y - maze_size_meters_.y / 2.0f) * PPM + top + camera_offset_y,
+        static_cast<float>(source.w),
+        static_cast<float>(source.h)
+    };
+    SDL_FPoint pivot = {maze_size_meters_.x / 2.0f * PPM - left, maze_size_meters_.y / 2.0f * PPM - top};
+    double angle_degrees = b2Rot_GetAngle(maze_body_transform.q) * 180.0 / M_PI;
+    SDL_RenderCopyExF(renderer, static_texture_, &source, &destination, angle_degrees, &pivot, SDL_FLIP_NONE);
+}
+
+// Per-frame path used when the texture cache isn't available
+void Maze::renderUncached(BatchRenderer& batch, const b2Transform& maze_body_transform, const b2AABB& visible_bounds,
+                          float camera_offset_x, float camera_offset_y) const {
+    const SDL_Color wall_color = {100, 100, 100, 255}; // Grey walls
+
+    wall_grid_.query(visible_bounds, visible_ids_);
+    for (int wall_index : visible_ids_) {
+        const WallSegment& segment = wall_segments_[wall_index];
+
         // Half-dimensions of the current wall segment
         float hx = segment.size_meters.x / 2.0f;
         float hy = segment.size_meters.y / 2.0f;
@@ -182,7 +476,7 @@ void Maze::render(SDL_Renderer* renderer, float camera_offset_x, float camera_of
             {-hx,  hy}  // Bottom-left
         };
 
-        SDL_Point screen_points[5]; // 4 corners + 1 to close the polygon
+        SDL_FPoint screen_points[4];
 
         for (int i = 0; i < 4; ++i) {
             // 1. Get the segment's corner position relative to the segment's center.
@@ -196,12 +490,29 @@ void Maze::render(SDL_Renderer* renderer, float camera_offset_x, float camera_of
             b2Vec2 world_corner_position = b2TransformPoint(maze_body_transform, corner_in_maze_body_frame);
 
             // 4. Convert world coordinates to screen coordinates
-            screen_points[i].x = static_cast<int>((world_corner_position.x * PPM) + camera_offset_x);
-            screen_points[i].y = static_cast<int>((world_corner_position.y * PPM) + camera_offset_y);
+            screen_points[i].x = (world_corner_position.x * PPM) + camera_offset_x;
+            screen_points[i].y = (world_corner_position.y * PPM) + camera_offset_y;
         }
-        screen_points[4] = screen_points[0]; // Close the polygon by repeating the first point
 
-        SDL_RenderDrawLines(renderer, screen_points, 5);
+        batch.strokeQuad(screen_points, 1.0f, wall_color);
+    }
+
+    auto to_screen = [&](b2Vec2 offset_from_center) {
+        b2Vec2 world_position = b2TransformPoint(maze_body_transform, offset_from_center);
+        return SDL_FPoint{(world_position.x * PPM) + camera_offset_x, (world_position.y * PPM) + camera_offset_y};
+    };
+
+    float margin = tile_size_meters_ / 2.0f;
+    if (goal_offset_meters_.x + margin >= visible_bounds.lowerBound.x && goal_offset_meters_.x - margin <= visible_bounds.upperBound.x &&
+        goal_offset_meters_.y + margin >= visible_bounds.lowerBound.y && goal_offset_meters_.y - margin <= visible_bounds.upperBound.y) {
+        SDL_FPoint goal = to_screen(goal_offset_meters_);
+        batch.fillCircle(goal.x, goal.y, TILE_SIZE / 2.0f, {0, 255, 0, 255}); // Green for the goal
+    }
+
+    hole_grid_.query(visible_bounds, visible_ids_);
+    for (int hole_index : visible_ids_) {
+        SDL_FPoint hole = to_screen(hole_offsets_meters_[hole_index]);
+        batch.fillCircle(hole.x, hole.y, (TILE_SIZE / 2.0f) * 0.9f, {0, 0, 0, 255}); // Black holes
     }
 }
 
@@ -222,6 +533,22 @@ void Maze::applyCurrentRotationToBodies() {
         // Since our maze_body_id_ is already positioned at its pivot (maze_center_world_coords_),
         // and this pivot point itself doesn't move in the world, we pass maze_center_world_coords_.
         b2Body_SetTransform(maze_body_id_, maze_center_world_coords_, new_rotation);
+        for (const WallChunk& chunk : wall_chunks_) {
+            if (chunk.enabled) {
+                b2Body_SetTransform(chunk.body_id, maze_center_world_coords_, new_rotation);
+            }
+        }
+    }
+}
+
+// Enabled chunks integrate the same angular velocity from the same transform as the main
+// body, so they turn in lockstep with it. Disabled ones are caught up when re-enabled.
+void Maze::setAngularVelocity(float angular_velocity) {
+    b2Body_SetAngularVelocity(maze_body_id_, angular_velocity);
+    for (const WallChunk& chunk : wall_chunks_) {
+        if (chunk.enabled) {
+            b2Body_SetAngularVelocity(chunk.body_id, angular_velocity);
+        }
     }
 }
 
@@ -233,8 +560,8 @@ void Maze::setRotationDirection(int direction) {
         // Convert rotation speed from degrees/sec to radians/sec
         float angular_velocity = static_cast<float>(direction) * (MAZE_TARGET_ROTATION_SPEED_DPS * M_PI / 180.0f);
         
-        // Apply angular velocity directly to the Box2D body
-        b2Body_SetAngularVelocity(maze_body_id_, angular_velocity);
+        // Apply angular velocity directly to the Box2D bodies
+        setAngularVelocity(angular_velocity);
         
         // When stopping, make sure to set the target to current rotation
         if (direction == 0) {
@@ -267,10 +594,10 @@ void Maze::update(float delta_time) {
         if (fabs(current_angular_velocity) > 0.001f) {
             // Apply damping to gradually stop rotation
             float damped_velocity = current_angular_velocity * 0.9f;
-            b2Body_SetAngularVelocity(maze_body_id_, damped_velocity);
+            setAngularVelocity(damped_velocity);
         } else if (fabs(current_angular_velocity) <= 0.001f) {
             // If very slow, just stop completely
-            b2Body_SetAngularVelocity(maze_body_id_, 0.0f);
+            setAngularVelocity(0.0f);
         }
     }
     
@@ -288,12 +615,103 @@ void Maze::resetRotation() {
     
     if (b2Body_IsValid(maze_body_id_)) {
         // Stop any rotation
-        b2Body_SetAngularVelocity(maze_body_id_, 0.0f);
+        setAngularVelocity(0.0f);
         // Reset position
-        b2Body_SetTransform(maze_body_id_, maze_center_world_coords_, b2MakeRot(0.0f));
+        applyCurrentRotationToBodies();
+        savePreviousTransform(); // Snap, don't blend the reset
     }
 } // Immediately update physical bodies
 
+void Maze::savePreviousTransform() {
+    if (b2Body_IsValid(maze_body_id_)) {
+        previous_transform_ = b2Body_GetTransform(maze_body_id_);
+    }
+}
+
+b2Transform Maze::getInterpolatedTransform(float alpha) const {
+    if (!b2Body_IsValid(maze_body_id_)) {
+        return previous_transform_;
+    }
+    b2Transform current = b2Body_GetTransform(maze_body_id_);
+    return {b2Lerp(previous_transform_.p, current.p, alpha), b2NLerp(previous_transform_.q, current.q, alpha)};
+}
+
+// Greedy rectangle cover: take the first uncovered wall tile in scan order, grow it
+// along the primary axis as far as it goes, then grow that run along the other axis
+// while every tile underneath is an uncovered wall. Both scan orders are tried and the
+// one producing fewer rectangles wins, which handles mazes dominated by vertical or
+// horizontal corridors equally well.
+std::vector<WallRect> Maze::mergeWallTiles(const std::vector<std::string>& layout) {
+    int grid_height = static_cast<int>(layout.size());
+    int grid_width = 0;
+    for (const auto& row : layout) {
+        grid_width = std::max(grid_width, static_cast<int>(row.size()));
+    }
+
+    auto is_wall = [&](int r, int c) {
+        return c < static_cast<int>(layout[r].size()) && layout[r][c] == '#';
+    };
+
+    auto merge = [&](bool rows_first) {
+        std::vector<WallRect> rects;
+        std::vector<char> covered(static_cast<size_t>(grid_width) * grid_height, 0);
+        auto free_wall = [&](int r, int c) {
+            return is_wall(r, c) && !covered[static_cast<size_t>(r) * grid_width + c];
+        };
+
+        int outer_count = rows_first ? grid_height : grid_width;
+        int inner_count = rows_first ? grid_width : grid_height;
+        for (int outer = 0; outer < outer_count; ++outer) {
+            for (int inner = 0; inner < inner_count; ++inner) {
+                int r = rows_first ? outer : inner;
+                int c = rows_first ? inner : outer;
+                if (!free_wall(r, c)) {
+                    continue;
+                }
+
+                WallRect rect = {c, r, 1, 1};
+                if (rows_first) {
+                    while (rect.col + rect.width < grid_width && free_wall(r, rect.col + rect.width)) {
+                        rect.width++;
+                    }
+                    while (rect.row + rect.height < grid_height) {
+                        bool full_run = true;
+                        for (int x = rect.col; x < rect.col + rect.width && full_run; ++x) {
+                            full_run = free_wall(rect.row + rect.height, x);
+                        }
+                        if (!full_run) break;
+                        rect.height++;
+                    }
+                } else {
+                    while (rect.row + rect.height < grid_height && free_wall(rect.row + rect.height, c)) {
+                        rect.height++;
+                    }
+                    while (rect.col + rect.width < grid_width) {
+                        bool full_run = true;
+                        for (int y = rect.row; y < rect.row + rect.height && full_run; ++y) {
+                            full_run = free_wall(y, rect.col + rect.width);
+                        }
+                        if (!full_run) break;
+                        rect.width++;
+                    }
+                }
+
+                for (int y = rect.row; y < rect.row + rect.height; ++y) {
+                    for (int x = rect.col; x < rect.col + rect.width; ++x) {
+                        covered[static_cast<size_t>(y) * grid_width + x] = 1;
+                    }
+                }
+                rects.push_back(rect);
+            }
+        }
+        return rects;
+    };
+
+    std::vector<WallRect> by_rows = merge(true);
+    std::vector<WallRect> by_columns = merge(false);
+    return by_columns.size() < by_rows.size() ? by_columns : by_rows;
+}
+
 float Maze::getCurrentRotationRad() const {
     return current_rotation_rad_;
 }
@@ -2,48 +2,145 @@
 #define MAZE_H
 
 #include <vector>
+#include <string>
+#include <cstdint>
 #include <SDL2/SDL.h>
 #include <box2d/box2d.h>
 #include "constants.h"
 #include "Level.h"
+#include "SpatialGrid.h"
+#include "BatchRenderer.h"
 
 struct WallSegment {
     b2Vec2 original_offset_from_center_meters; // Relative to maze center, before rotation
     b2Vec2 size_meters;
 };
 
+// Walls of one square region of the maze, on their own kinematic body. The body sits at the
+// maze pivot with the same rotation and angular velocity as the main maze body, so its shapes
+// keep the offsets they would have on the main body.
+struct WallChunk {
+    b2BodyId body_id;
+    b2AABB bounds;  // Around its wall shapes, in maze body coordinates
+    bool enabled;   // In the broadphase and simulated
+};
+
+// A solid block of '#' tiles in grid coordinates, produced by Maze::mergeWallTiles
+struct WallRect {
+    int col;
+    int row;
+    int width;  // In tiles
+    int height; // In tiles
+};
+
+// What a sensor shape on the maze body stands for. The type and an index into the
+// matching Game container are packed into the shape's userData, so a sensor event
+// can be dispatched straight to its object.
+enum class TriggerType : uintptr_t {
+    NONE = 0,
+    HOLE,
+    GOAL,
+    WARP,
+    REVERSE_ITEM
+};
+
+struct Trigger {
+    TriggerType type;
+    int index;
+
+    static void* pack(TriggerType type, int index) {
+        return reinterpret_cast<void*>((static_cast<uintptr_t>(type) << 24) | (static_cast<uintptr_t>(index) & 0xFFFFFF));
+    }
+    static Trigger unpack(void* user_data) {
+        uintptr_t bits = reinterpret_cast<uintptr_t>(user_data);
+        return {static_cast<TriggerType>(bits >> 24), static_cast<int>(bits & 0xFFFFFF)};
+    }
+};
+
 class Maze {
 public:
     Maze(b2WorldId worldId);
     ~Maze();
 
     void create(const Level& level, b2Vec2 maze_world_origin_meters);
-    void render(SDL_Renderer* renderer, float camera_offset_x, float camera_offset_y) const;
+    // alpha blends from the body transform before the last physics step (0) to the current one (1).
+    // The cached texture is copied right away; without the cache the walls, holes and goal
+    // are added to `batch`, which the caller flushes.
+    void render(SDL_Renderer* renderer, BatchRenderer& batch, float camera_offset_x, float camera_offset_y, float alpha = 1.0f) const;
+
+    // Draws the unrotated walls, holes and goal once into a render-target texture, so
+    // render() presents the whole maze with a single SDL_RenderCopyEx per frame. Call after
+    // create() and again when SDL reports lost render targets. Returns false when render
+    // targets can't be used; render() then keeps drawing everything per frame.
+    bool buildRenderCache(SDL_Renderer* renderer);
+    void releaseRenderCache();
     void setRotationDirection(int direction); // -1 for left, 1 for right, 0 for stop
     void update(float delta_time); // Smoothly rotates towards target_rotation_rad_ using discrete steps
     void resetRotation(); // Resets maze rotation to 0
 
+    // Render interpolation, see Ball::savePreviousTransform
+    void savePreviousTransform();
+    b2Transform getInterpolatedTransform(float alpha) const;
+
+    // The screen rectangle seen through the camera, as a box in maze body coordinates.
+    // Anything on the maze outside it is off screen.
+    b2AABB getVisibleLocalBounds(const b2Transform& maze_body_transform, float camera_offset_x, float camera_offset_y) const;
+
     // Getters for Game class to use for rotating other elements
     float getCurrentRotationRad() const;
     b2Vec2 getMazeCenterWorldCoords() const;
     bool isRotating() const; // Check if maze is currently rotating
+
+    // Gameplay sensors live on the maze body so Box2D carries them around with the walls
+    b2BodyId getBodyId() const { return maze_body_id_; }
+    b2Vec2 gridToLocal(b2Vec2 grid_position) const; // Tile center in maze body coordinates
+    b2ShapeId addSensor(b2Vec2 local_position, float radius, void* user_data);
+
+    // Walls are split into chunk bodies that start disabled. This enables the chunks within
+    // reach of `bodies` (what they and the turning maze can cover in lookahead_seconds, plus
+    // a margin) and disables the ones they have left well behind, so Box2D only moves and
+    // tests the walls near the balls. Call before every b2World_Step.
+    void updateActiveChunks(const std::vector<b2BodyId>& bodies, float lookahead_seconds);
+    int getChunkCount() const { return static_cast<int>(wall_chunks_.size()); }
+    int getEnabledChunkCount() const;
+
+    // Covers every '#' tile of the layout with as few non-overlapping rectangles as
+    // the greedy pass can find, so each rectangle becomes a single Box2D shape.
+    static std::vector<WallRect> mergeWallTiles(const std::vector<std::string>& layout);
     
     // No longer need discrete rotation step method - using continuous rotation
 
 private:
+    struct ChunkProbe {
+        b2Vec2 local_position; // Body center in maze body coordinates
+        float reach;           // Body extent plus how far it can move against the walls
+    };
+
+    void destroyBodies();
+    void setAngularVelocity(float angular_velocity); // Main body and enabled chunks together
     void applyCurrentRotationToBodies();
+    void renderUncached(BatchRenderer& batch, const b2Transform& maze_body_transform, const b2AABB& visible_bounds,
+                        float camera_offset_x, float camera_offset_y) const;
 
     b2WorldId worldId_;
     std::vector<WallSegment> wall_segments_; // Stores visual/geometric info for rendering
-    b2BodyId maze_body_id_; // Single body for the entire maze structure
+    std::vector<b2Vec2> hole_offsets_meters_; // Hole centers relative to maze center, before rotation
+    b2Vec2 goal_offset_meters_;               // Goal center relative to maze center, before rotation
+    SpatialGrid wall_grid_;                   // wall_segments_ indices, in maze body coordinates
+    SpatialGrid hole_grid_;                   // hole_offsets_meters_ indices
+    mutable std::vector<int> visible_ids_;    // Scratch for grid queries while rendering
+    b2Vec2 maze_size_meters_;
+    SDL_Texture* static_texture_ = nullptr;   // Walls, holes and goal at 0 rotation, see buildRenderCache
+    b2BodyId maze_body_id_; // Sensors and the outer boundary; its transform is the maze transform
+    std::vector<WallChunk> wall_chunks_;
+    std::vector<ChunkProbe> chunk_probes_; // Scratch for updateActiveChunks
+    b2Transform previous_transform_ = b2Transform_identity; // Body transform before the last step
     b2Vec2 maze_center_world_coords_; // Calculated center of the maze in world space
+    b2Vec2 maze_origin_world_coords_; // Top-left corner of the grid in world space
     float current_rotation_rad_;      // Changed from degrees to radians
     float target_rotation_rad_;       // The rotation angle the maze is moving towards
     int rotation_direction_ = 0; // -1 for left, 1 for right, 0 for stop
     float tile_size_meters_;
-    
-    // Using continuous rotation via angular velocity now
-    // SDL_Texture* wall_texture_; // Optional
 };
 
 #endif // MAZE_H
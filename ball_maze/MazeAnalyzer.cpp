@@ -0,0 +1,273 @@
+#include "MazeAnalyzer.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <functional>
+#include <queue>
+#include <thread>
+#include <tuple>
+#include "constants.h"
+
+namespace {
+
+// A solid disc rolling without slipping accelerates at 2/3 of the gravity along its path
+const float ROLLING_ACCELERATION = WORLD_GRAVITY_Y * BALL_GRAVITY_SCALE * (2.0f / 3.0f);
+const float TILE_METERS = TILE_SIZE / PPM;
+
+} // namespace
+
+MazeAnalyzer::MazeAnalyzer(const LevelData& level, int rotation_buckets)
+    : level_(level),
+      rotation_buckets_(std::max(4, rotation_buckets)),
+      seconds_per_rotation_((360.0f / std::max(4, rotation_buckets)) / MAZE_TARGET_ROTATION_SPEED_DPS) {
+}
+
+bool MazeAnalyzer::isOpen(int x, int y) const {
+    return y >= 0 && y < static_cast<int>(level_.layout.size()) &&
+           x >= 0 && x < static_cast<int>(level_.layout[y].size()) && level_.layout[y][x] != '#';
+}
+
+MazeAnalyzer::Cell MazeAnalyzer::warpPartner(Cell warp) const {
+    // Same pairing as Warp::handleWarpCollision: the first other warp with the same id
+    char id = at(warp.x, warp.y);
+    for (const auto& [warp_id, position] : level_.warp_positions) {
+        Cell cell = {static_cast<int>(position.x), static_cast<int>(position.y)};
+        if (at(cell.x, cell.y) == id && (cell.x != warp.x || cell.y != warp.y)) {
+            return cell;
+        }
+    }
+    return {-1, -1};
+}
+
+MazeAnalyzer::Roll MazeAnalyzer::roll(Cell from, int bucket) const {
+    // Gravity (0, 1) seen from a maze turned by `angle`, snapped to one of the 8 directions
+    float angle = bucket * 2.0f * static_cast<float>(M_PI) / rotation_buckets_;
+    float gravity_x = std::sin(angle);
+    float gravity_y = std::cos(angle);
+    const float SNAP = 0.38f; // sin(22.5 degrees)
+    int dx = gravity_x > SNAP ? 1 : (gravity_x < -SNAP ? -1 : 0);
+    int dy = gravity_y > SNAP ? 1 : (gravity_y < -SNAP ? -1 : 0);
+
+    Cell cell = from;
+    int cells_rolled = 0;
+    float distance = 0.0f;
+    float acceleration = 0.0f;
+    std::vector<Cell> used_warps; // Both ends of a warp cool down after a teleport
+    int max_moves = static_cast<int>(level_.layout.size() * (level_.layout.empty() ? 0 : level_.layout[0].size())) * 2;
+
+    for (int move = 0; move < max_moves; ++move) {
+        // Diagonal gravity rolls diagonally through open corners and slides along a wall
+        // otherwise; balanced on a corner, the ball stays put
+        int step_x = 0;
+        int step_y = 0;
+        if (dx != 0 && dy != 0) {
+            bool open_x = isOpen(cell.x + dx, cell.y);
+            bool open_y = isOpen(cell.x, cell.y + dy);
+            if (open_x && open_y && isOpen(cell.x + dx, cell.y + dy)) {
+                step_x = dx;
+                step_y = dy;
+            } else if (open_x && !open_y) {
+                step_x = dx;
+            } else if (open_y && !open_x) {
+                step_y = dy;
+            }
+        } else if (isOpen(cell.x + dx, cell.y + dy)) {
+            step_x = dx;
+            step_y = dy;
+        }
+
+        if (step_x == 0 && step_y == 0) {
+            float seconds = distance > 0.0f ? std::sqrt(2.0f * distance / acceleration) : 0.0f;
+            return {RollEnd::REST, cell, cells_rolled, seconds};
+        }
+
+        float step_length = std::sqrt(static_cast<float>(step_x * step_x + step_y * step_y));
+        if (cells_rolled == 0) {
+            // Gravity along the first move; later turns are ignored for the time estimate
+            float alignment = (gravity_x * step_x + gravity_y * step_y) / step_length;
+            acceleration = ROLLING_ACCELERATION * std::max(alignment, 0.5f);
+        }
+        cell = {cell.x + step_x, cell.y + step_y};
+        cells_rolled++;
+        distance += step_length * TILE_METERS;
+
+        char tile = at(cell.x, cell.y);
+        if (tile == 'G' || tile == 'H') {
+            float seconds = std::sqrt(2.0f * distance / acceleration);
+            return {tile == 'G' ? RollEnd::GOAL : RollEnd::HOLE, cell, cells_rolled, seconds};
+        }
+        if (tile >= '1' && tile <= '9') {
+            bool used = std::any_of(used_warps.begin(), used_warps.end(),
+                                    [&](const Cell& warp) { return warp.x == cell.x && warp.y == cell.y; });
+            Cell partner = used ? Cell{-1, -1} : warpPartner(cell);
+            if (partner.x >= 0) {
+                used_warps.push_back(cell);
+                used_warps.push_back(partner);
+                cell = partner; // Keeps rolling (and keeps its speed) from the other end
+            }
+        }
+    }
+    return {RollEnd::LOOP, cell, cells_rolled, 0.0f};
+}
+
+LevelAnalysis MazeAnalyzer::analyzeBall(Cell start) const {
+    LevelAnalysis result;
+    int width = level_.layout.empty() ? 0 : static_cast<int>(level_.layout[0].size());
+    int height = static_cast<int>(level_.layout.size());
+    int cells = width * height;
+
+    // The ball drops as soon as the level starts, before any input
+    Roll first = roll(start, 0);
+    if (first.end == RollEnd::GOAL) {
+        result.solvable = true;
+        result.min_rotations = 0;
+        result.par_time_seconds = first.seconds;
+        return result;
+    }
+    if (first.end != RollEnd::REST) {
+        result.problem = first.end == RollEnd::HOLE ? "falls into a hole at the start" : "warps in a loop at the start";
+        return result;
+    }
+
+    // Dijkstra over (bucket, cell). by_time picks the cost that is minimized first; the other
+    // one breaks ties. A hole puts the ball back at the start, which never helps, so it's a dead end.
+    const int GOAL_STATE = rotation_buckets_ * cells;
+    auto search = [&](bool by_time, int& rotations, float& seconds, std::vector<int>* route) {
+        // primary, secondary, rotations, state, previous state, turn that led here
+        using Entry = std::tuple<float, float, int, int, int, int>;
+        std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> open;
+        std::vector<bool> done(GOAL_STATE + 1, false);
+        std::vector<std::pair<int, int>> came_from(GOAL_STATE + 1, {-1, 0});
+        auto push = [&](int state, int state_rotations, float state_seconds, int previous, int turn) {
+            float rotation_cost = static_cast<float>(state_rotations);
+            open.push(by_time ? Entry{state_seconds, rotation_cost, state_rotations, state, previous, turn}
+                              : Entry{rotation_cost, state_seconds, state_rotations, state, previous, turn});
+        };
+        push(first.cell.y * width + first.cell.x, 0, first.seconds, -1, 0);
+
+        int explored = 0;
+        while (!open.empty()) {
+            auto [primary, secondary, state_rotations, state, previous, turn_taken] = open.top();
+            open.pop();
+            if (done[state]) {
+                continue;
+            }
+            done[state] = true;
+            came_from[state] = {previous, turn_taken};
+            explored++;
+
+            float state_seconds = by_time ? primary : secondary;
+            if (state == GOAL_STATE) {
+                rotations = state_rotations;
+                seconds = state_seconds;
+                if (route) {
+                    route->clear();
+                    for (int step = GOAL_STATE; came_from[step].first >= 0; step = came_from[step].first) {
+                        route->push_back(came_from[step].second);
+                    }
+                    std::reverse(route->begin(), route->end());
+                }
+                return explored;
+            }
+
+            int bucket = state / cells;
+            Cell cell = {(state % cells) % width, (state % cells) / width};
+            for (int turn : {-1, 1}) {
+                int next_bucket = (bucket + turn + rotation_buckets_) % rotation_buckets_;
+                Roll next = roll(cell, next_bucket);
+                float next_seconds = state_seconds + seconds_per_rotation_ + next.seconds;
+                if (next.end == RollEnd::GOAL) {
+                    push(GOAL_STATE, state_rotations + 1, next_seconds, state, turn);
+                } else if (next.end == RollEnd::REST) {
+                    int next_state = next_bucket * cells + next.cell.y * width + next.cell.x;
+                    if (!done[next_state]) {
+                        push(next_state, state_rotations + 1, next_seconds, state, turn);
+                    }
+                }
+            }
+        }
+        return -explored; // Goal unreachable
+    };
+
+    float unused_seconds = 0.0f;
+    int unused_rotations = 0;
+    int explored = search(false, result.min_rotations, unused_seconds, &result.solution);
+    if (explored < 0) {
+        result.states_explored = -explored;
+        result.min_rotations = -1;
+        result.problem = "can't reach the goal";
+        return result;
+    }
+    result.states_explored = explored;
+    result.states_explored += std::abs(search(true, unused_rotations, result.par_time_seconds, nullptr));
+    result.solvable = true;
+    return result;
+}
+
+LevelAnalysis MazeAnalyzer::analyze() const {
+    LevelAnalysis result;
+    if (level_.layout.empty()) {
+        result.problem = "empty layout";
+        return result;
+    }
+    bool has_goal = std::any_of(level_.layout.begin(), level_.layout.end(),
+                                [](const std::string& row) { return row.find('G') != std::string::npos; });
+    if (!has_goal) {
+        result.problem = "no goal ('G')";
+        return result;
+    }
+    if (level_.ball_start_positions.empty()) {
+        result.problem = "no ball start ('O')";
+        return result;
+    }
+
+    // Every ball has to make it; report the slowest one
+    result.solvable = true;
+    result.min_rotations = 0;
+    for (size_t i = 0; i < level_.ball_start_positions.size(); ++i) {
+        b2Vec2 start = level_.ball_start_positions[i];
+        LevelAnalysis ball = analyzeBall({static_cast<int>(start.x), static_cast<int>(start.y)});
+        result.states_explored += ball.states_explored;
+        if (!ball.solvable) {
+            result.solvable = false;
+            result.min_rotations = -1;
+            result.par_time_seconds = 0.0f;
+            result.problem = level_.ball_start_positions.size() > 1
+                ? "ball " + std::to_string(i + 1) + " " + ball.problem
+                : "ball " + ball.problem;
+            return result;
+        }
+        result.min_rotations = std::max(result.min_rotations, ball.min_rotations);
+        result.par_time_seconds = std::max(result.par_time_seconds, ball.par_time_seconds);
+        if (level_.ball_start_positions.size() == 1) {
+            result.solution = std::move(ball.solution);
+        }
+    }
+    return result;
+}
+
+std::vector<LevelAnalysis> MazeAnalyzer::analyzeAll(const std::vector<LevelData>& levels, int rotation_buckets, int jobs) {
+    std::vector<LevelAnalysis> results(levels.size());
+    if (jobs <= 0) {
+        jobs = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    }
+    jobs = std::max(1, std::min(jobs, static_cast<int>(levels.size())));
+
+    // Levels vary a lot in size, so threads pull the next level instead of taking a fixed share
+    std::atomic<size_t> next_level{0};
+    auto worker = [&]() {
+        for (size_t i = next_level++; i < levels.size(); i = next_level++) {
+            results[i] = MazeAnalyzer(levels[i], rotation_buckets).analyze();
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (int i = 1; i < jobs; ++i) {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    return results;
+}
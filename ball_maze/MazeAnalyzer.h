@@ -0,0 +1,69 @@
+#ifndef MAZE_ANALYZER_H
+#define MAZE_ANALYZER_H
+
+#include <string>
+#include <vector>
+#include "Level.h"
+
+struct LevelAnalysis {
+    bool solvable = false;
+    int min_rotations = -1;         // Fewest rotation steps (of 360/rotation_buckets degrees) to the goal
+    float par_time_seconds = 0.0f;  // Fastest route found, rotation plus rolling time
+    int states_explored = 0;
+    std::string problem;            // Why the level isn't solvable, empty otherwise
+    // Fewest-rotations route as one +1/-1 per step (+1 turns the maze like the right key with
+    // normal controls). Only filled for single-ball levels.
+    std::vector<int> solution;
+};
+
+// Static solvability check for a level, without running Box2D.
+//
+// The maze angle is quantized into rotation buckets. In each bucket, gravity in the maze's
+// frame points along one of the 8 grid directions, and the ball rolls cell by cell until
+// something stops it. A search state is (rotation bucket, resting cell). Turning the maze
+// by one bucket moves the ball to the next state. While the ball rolls:
+// - it is lost in a hole
+// - it wins on the goal
+// - a warp sends it to its partner, and it keeps rolling from there
+// Reverse items only swap the keys, so they don't change what is reachable.
+// Crates are treated as empty floor.
+//
+// Levels with several balls are checked one ball at a time. That is optimistic: in the
+// game, every ball turns with the same maze.
+class MazeAnalyzer {
+public:
+    explicit MazeAnalyzer(const LevelData& level, int rotation_buckets = 8);
+
+    LevelAnalysis analyze() const;
+
+    // Analyzes every level with `jobs` threads (0 = one per hardware thread); results keep
+    // the order of `levels`
+    static std::vector<LevelAnalysis> analyzeAll(const std::vector<LevelData>& levels, int rotation_buckets, int jobs);
+
+private:
+    struct Cell {
+        int x;
+        int y;
+    };
+
+    // Where a roll under the gravity of `bucket` ends
+    enum class RollEnd { REST, GOAL, HOLE, LOOP };
+    struct Roll {
+        RollEnd end;
+        Cell cell;
+        int cells_rolled;
+        float seconds;
+    };
+
+    LevelAnalysis analyzeBall(Cell start) const;
+    Roll roll(Cell from, int bucket) const;
+    bool isOpen(int x, int y) const;
+    char at(int x, int y) const { return level_.layout[y][x]; }
+    Cell warpPartner(Cell warp) const;
+
+    const LevelData& level_;
+    int rotation_buckets_;
+    float seconds_per_rotation_; // One bucket at MAZE_TARGET_ROTATION_SPEED_DPS
+};
+
+#endif // MAZE_ANALYZER_H
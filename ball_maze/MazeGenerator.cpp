@@ -0,0 +1,195 @@
+#include "MazeGenerator.h"
+#include <algorithm>
+#include <iomanip>
+#include <queue>
+#include <random>
+#include <sstream>
+
+namespace {
+
+// splitmix64, to turn (seed, counter) pairs into well spread generator seeds
+uint64_t mixSeed(uint64_t value) {
+    value += 0x9E3779B97F4A7C15ull;
+    value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+    value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+    return value ^ (value >> 31);
+}
+
+int roundUpToOdd(int value) {
+    return value % 2 == 0 ? value + 1 : value;
+}
+
+} // namespace
+
+MazeGenerator::MazeGenerator(const GeneratorSettings& settings)
+    : difficulty_(std::max(1, std::min(settings.difficulty, 10))),
+      max_attempts_(std::max(1, settings.max_attempts)) {
+    int size = 9 + 2 * difficulty_;
+    width_ = roundUpToOdd(std::max(7, settings.width > 0 ? settings.width : size));
+    height_ = roundUpToOdd(std::max(7, settings.height > 0 ? settings.height : size));
+    holes_ = settings.holes >= 0 ? settings.holes : difficulty_ * (difficulty_ - 1) / 4;
+    warp_pairs_ = std::min(9, settings.warp_pairs >= 0 ? settings.warp_pairs : difficulty_ / 3);
+    reverse_items_ = settings.reverse_items >= 0 ? settings.reverse_items : (difficulty_ >= 4 ? (difficulty_ - 1) / 3 : 0);
+    min_rotations_ = difficulty_ + 1;
+    max_rotations_ = 3 * difficulty_ + 6;
+}
+
+uint64_t MazeGenerator::levelSeed(uint64_t pack_seed, int index) {
+    return mixSeed(pack_seed ^ mixSeed(static_cast<uint64_t>(index)));
+}
+
+std::string MazeGenerator::difficultyName(int difficulty) {
+    if (difficulty <= 3) {
+        return "Easy";
+    }
+    if (difficulty <= 6) {
+        return "Medium";
+    }
+    return difficulty <= 8 ? "Hard" : "Expert";
+}
+
+std::vector<std::string> MazeGenerator::carve(uint64_t seed) const {
+    std::mt19937_64 random(seed);
+    std::vector<std::string> layout(height_, std::string(width_, '#'));
+
+    // Depth-first backtracker over the odd tiles; the even ones between them are walls
+    std::vector<Tile> stack = {{1, 1}};
+    layout[1][1] = '.';
+    const Tile DIRECTIONS[4] = {{2, 0}, {-2, 0}, {0, 2}, {0, -2}};
+    while (!stack.empty()) {
+        Tile tile = stack.back();
+        Tile options[4];
+        int option_count = 0;
+        for (const Tile& direction : DIRECTIONS) {
+            int x = tile.x + direction.x;
+            int y = tile.y + direction.y;
+            if (x > 0 && x < width_ - 1 && y > 0 && y < height_ - 1 && layout[y][x] == '#') {
+                options[option_count++] = direction;
+            }
+        }
+        if (option_count == 0) {
+            stack.pop_back();
+            continue;
+        }
+        Tile direction = options[random() % option_count];
+        layout[tile.y + direction.y / 2][tile.x + direction.x / 2] = '.';
+        layout[tile.y + direction.y][tile.x + direction.x] = '.';
+        stack.push_back({tile.x + direction.x, tile.y + direction.y});
+    }
+
+    // A perfect maze leaves one way to roll anywhere; knocking out some walls between two
+    // corridors adds loops and open spots. Harder levels keep more of the maze intact.
+    int openings = (width_ * height_) / (10 + 2 * difficulty_);
+    for (int i = 0; i < openings * 4 && openings > 0; ++i) {
+        int x = 1 + static_cast<int>(random() % (width_ - 2));
+        int y = 1 + static_cast<int>(random() % (height_ - 2));
+        bool between_x = layout[y][x - 1] == '.' && layout[y][x + 1] == '.';
+        bool between_y = layout[y - 1][x] == '.' && layout[y + 1][x] == '.';
+        if (layout[y][x] == '#' && (between_x != between_y)) {
+            layout[y][x] = '.';
+            openings--;
+        }
+    }
+    return layout;
+}
+
+bool MazeGenerator::placeObjects(std::vector<std::string>& layout, uint64_t seed) const {
+    std::mt19937_64 random(seed);
+    std::vector<Tile> floor;
+    for (int y = 0; y < height_; ++y) {
+        for (int x = 0; x < width_; ++x) {
+            if (layout[y][x] == '.') {
+                floor.push_back({x, y});
+            }
+        }
+    }
+    std::shuffle(floor.begin(), floor.end(), random);
+
+    // Start in the top third, so the ball has a maze to work through below it
+    auto start = std::find_if(floor.begin(), floor.end(), [this](const Tile& tile) { return tile.y <= height_ / 3; });
+    if (start == floor.end()) {
+        return false;
+    }
+    Tile ball = *start;
+    layout[ball.y][ball.x] = 'O';
+
+    // Goal on the tile furthest from the start along the corridors
+    std::vector<int> distance(width_ * height_, -1);
+    std::queue<Tile> open;
+    open.push(ball);
+    distance[ball.y * width_ + ball.x] = 0;
+    Tile goal = ball;
+    while (!open.empty()) {
+        Tile tile = open.front();
+        open.pop();
+        if (distance[tile.y * width_ + tile.x] > distance[goal.y * width_ + goal.x]) {
+            goal = tile;
+        }
+        const Tile NEIGHBOURS[4] = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}};
+        for (const Tile& step : NEIGHBOURS) {
+            Tile next = {tile.x + step.x, tile.y + step.y};
+            if (layout[next.y][next.x] != '#' && distance[next.y * width_ + next.x] < 0) {
+                distance[next.y * width_ + next.x] = distance[tile.y * width_ + tile.x] + 1;
+                open.push(next);
+            }
+        }
+    }
+    layout[goal.y][goal.x] = 'G';
+
+    // Holes, warps and reverse items on the remaining floor, in shuffled order
+    size_t next_tile = 0;
+    auto take = [&](char object) {
+        while (next_tile < floor.size()) {
+            Tile tile = floor[next_tile++];
+            if (layout[tile.y][tile.x] == '.') {
+                layout[tile.y][tile.x] = object;
+                return true;
+            }
+        }
+        return false;
+    };
+    for (int i = 0; i < holes_; ++i) {
+        if (!take('H')) {
+            return false;
+        }
+    }
+    for (int i = 0; i < warp_pairs_; ++i) {
+        if (!take(static_cast<char>('1' + i)) || !take(static_cast<char>('1' + i))) {
+            return false;
+        }
+    }
+    for (int i = 0; i < reverse_items_; ++i) {
+        if (!take('R')) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool MazeGenerator::generate(uint64_t seed, LevelData& level, LevelAnalysis& analysis) const {
+    for (int attempt = 0; attempt < max_attempts_; ++attempt) {
+        uint64_t attempt_seed = mixSeed(seed + static_cast<uint64_t>(attempt) * 0x9E3779B97F4A7C15ull);
+        LevelData candidate;
+        candidate.layout = carve(attempt_seed);
+        if (!placeObjects(candidate.layout, mixSeed(attempt_seed))) {
+            continue;
+        }
+        Level::indexGridObjects(candidate);
+
+        LevelAnalysis result = MazeAnalyzer(candidate).analyze();
+        if (!result.solvable || result.min_rotations < min_rotations_ || result.min_rotations > max_rotations_) {
+            continue;
+        }
+
+        std::ostringstream description;
+        description << result.min_rotations << " rotations, par " << std::fixed << std::setprecision(1)
+                    << result.par_time_seconds << " s";
+        candidate.name = "Seed " + std::to_string(seed);
+        candidate.description = description.str();
+        candidate.difficulty = difficultyName(difficulty_);
+        level = std::move(candidate);
+        analysis = std::move(result);
+        return true;
+    }
+    return false;
+}
@@ -0,0 +1,56 @@
+#ifndef MAZE_GENERATOR_H
+#define MAZE_GENERATOR_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Level.h"
+#include "MazeAnalyzer.h"
+
+// What to generate. Everything left at -1 (or 0 for the size) follows from difficulty.
+struct GeneratorSettings {
+    int difficulty = 3;     // 1 (a few turns in a small maze) to 10 (large, holes, warps, reverse items)
+    int width = 0;          // Grid size including the outer wall, rounded up to odd
+    int height = 0;
+    int holes = -1;
+    int warp_pairs = -1;    // Up to 9, warps '1' to '9'
+    int reverse_items = -1;
+    int max_attempts = 500; // Candidate mazes tried per level before giving up
+};
+
+// Random rotating-ball mazes in the pack format. A candidate is a carved maze with a few
+// extra openings (so there is more than one way to roll), then a start, a goal, holes, warps
+// and reverse items on random floor tiles. MazeAnalyzer keeps only candidates that are
+// solvable within the difficulty's rotation range. Generation is deterministic for a seed.
+class MazeGenerator {
+public:
+    explicit MazeGenerator(const GeneratorSettings& settings);
+
+    // False if no candidate passed within max_attempts. analysis describes the level returned.
+    bool generate(uint64_t seed, LevelData& level, LevelAnalysis& analysis) const;
+
+    // Seed of level `index` of a pack, so every level of a pack can be made independently
+    static uint64_t levelSeed(uint64_t pack_seed, int index);
+    static std::string difficultyName(int difficulty);
+
+private:
+    struct Tile {
+        int x;
+        int y;
+    };
+
+    std::vector<std::string> carve(uint64_t seed) const;
+    bool placeObjects(std::vector<std::string>& layout, uint64_t seed) const;
+
+    int difficulty_;
+    int width_;
+    int height_;
+    int holes_;
+    int warp_pairs_;
+    int reverse_items_;
+    int min_rotations_; // Accepted rotation range for the difficulty
+    int max_rotations_;
+    int max_attempts_;
+};
+
+#endif // MAZE_GENERATOR_H
@@ -0,0 +1,180 @@
+#include "Profiler.h"
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+namespace {
+
+const char* const PHASE_NAMES[] = {"Input", "Update", "Physics", "Render"};
+
+// Bar colors in the overlay, one per phase
+const SDL_Color PHASE_COLORS[] = {
+    {80, 160, 255, 255},  // Input
+    {255, 220, 80, 255},  // Update (without physics)
+    {255, 120, 40, 255},  // Physics
+    {80, 220, 120, 255},  // Render
+};
+
+const float OVERLAY_RANGE_MS = 1000.0f / 30.0f; // Overlay height maps to a 30 fps frame
+
+} // namespace
+
+Profiler::Profiler() : epoch_(Clock::now()), frames_(HISTORY_FRAMES) {
+}
+
+void Profiler::beginFrame() {
+    frame_start_ = Clock::now();
+    frames_[next_frame_] = Frame();
+    frames_[next_frame_].start_us = std::chrono::duration<double, std::micro>(frame_start_ - epoch_).count();
+    in_frame_ = true;
+}
+
+void Profiler::endFrame() {
+    if (!in_frame_) {
+        return;
+    }
+    frames_[next_frame_].duration_us = std::chrono::duration<float, std::micro>(Clock::now() - frame_start_).count();
+    next_frame_ = (next_frame_ + 1) % HISTORY_FRAMES;
+    recorded_frames_ = std::min(recorded_frames_ + 1, HISTORY_FRAMES);
+    in_frame_ = false;
+}
+
+void Profiler::addSpan(ProfilePhase phase, Clock::time_point start, Clock::time_point end) {
+    if (!in_frame_) {
+        return;
+    }
+    Frame& frame = frames_[next_frame_];
+    float duration_us = std::chrono::duration<float, std::micro>(end - start).count();
+    frame.phase_us[static_cast<int>(phase)] += duration_us;
+    if (frame.span_count < MAX_SPANS_PER_FRAME) {
+        frame.spans[frame.span_count++] = {phase, std::chrono::duration<float, std::micro>(start - frame_start_).count(), duration_us};
+    }
+}
+
+void Profiler::addBox2DProfile(const b2Profile& profile) {
+    if (!in_frame_) {
+        return;
+    }
+    Frame& frame = frames_[next_frame_];
+    frame.physics_steps++;
+    frame.box2d.step += profile.step;
+    frame.box2d.pairs += profile.pairs;
+    frame.box2d.collide += profile.collide;
+    frame.box2d.solve += profile.solve;
+    frame.box2d.refit += profile.refit;
+    frame.box2d.sensors += profile.sensors;
+}
+
+const Profiler::Frame& Profiler::frameAt(int age) const {
+    return frames_[(next_frame_ - 1 - age + 2 * HISTORY_FRAMES) % HISTORY_FRAMES];
+}
+
+float Profiler::getAverageFrameMs() const {
+    if (recorded_frames_ == 0) {
+        return 0.0f;
+    }
+    double total_us = 0.0;
+    for (int age = 0; age < recorded_frames_; ++age) {
+        total_us += frameAt(age).duration_us;
+    }
+    return static_cast<float>(total_us / recorded_frames_ / 1000.0);
+}
+
+float Profiler::getAveragePhaseMs(ProfilePhase phase) const {
+    if (recorded_frames_ == 0) {
+        return 0.0f;
+    }
+    double total_us = 0.0;
+    for (int age = 0; age < recorded_frames_; ++age) {
+        total_us += frameAt(age).phase_us[static_cast<int>(phase)];
+    }
+    return static_cast<float>(total_us / recorded_frames_ / 1000.0);
+}
+
+void Profiler::renderOverlay(SDL_Renderer* renderer, const SDL_Rect& area) const {
+    SDL_BlendMode previous_blend;
+    SDL_GetRenderDrawBlendMode(renderer, &previous_blend);
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 160);
+    SDL_RenderFillRect(renderer, &area);
+
+    // One pixel column per frame, newest on the right
+    float pixels_per_us = area.h / (OVERLAY_RANGE_MS * 1000.0f);
+    int bars = std::min(recorded_frames_, area.w);
+    for (int age = 0; age < bars; ++age) {
+        const Frame& frame = frameAt(age);
+        float x = static_cast<float>(area.x + area.w - 1 - age);
+        float bottom = static_cast<float>(area.y + area.h);
+
+        // Physics is part of Update; draw it as its own segment instead of twice
+        float heights_us[] = {
+            frame.phase_us[static_cast<int>(ProfilePhase::INPUT)],
+            frame.phase_us[static_cast<int>(ProfilePhase::UPDATE)] - frame.phase_us[static_cast<int>(ProfilePhase::PHYSICS)],
+            frame.phase_us[static_cast<int>(ProfilePhase::PHYSICS)],
+            frame.phase_us[static_cast<int>(ProfilePhase::RENDER)],
+        };
+        for (int phase = 0; phase < 4; ++phase) {
+            float height = std::max(0.0f, heights_us[phase]) * pixels_per_us;
+            float top = std::max(bottom - height, static_cast<float>(area.y));
+            SDL_SetRenderDrawColor(renderer, PHASE_COLORS[phase].r, PHASE_COLORS[phase].g, PHASE_COLORS[phase].b, 255);
+            SDL_RenderDrawLineF(renderer, x, bottom, x, top);
+            bottom = top;
+        }
+
+        // Whatever the timers didn't cover (waiting for the frame cap, SDL_RenderPresent)
+        float top = std::max(area.y + area.h - frame.duration_us * pixels_per_us, static_cast<float>(area.y));
+        if (top < bottom) {
+            SDL_SetRenderDrawColor(renderer, 120, 120, 120, 255);
+            SDL_RenderDrawLineF(renderer, x, bottom, x, top);
+        }
+    }
+
+    // 60 fps and 30 fps budgets
+    SDL_SetRenderDrawColor(renderer, 255, 255, 255, 200);
+    int sixty_fps_y = area.y + area.h - static_cast<int>(area.h * (1000.0f / 60.0f) / OVERLAY_RANGE_MS);
+    SDL_RenderDrawLine(renderer, area.x, sixty_fps_y, area.x + area.w, sixty_fps_y);
+    SDL_RenderDrawLine(renderer, area.x, area.y, area.x + area.w, area.y);
+    SDL_SetRenderDrawBlendMode(renderer, previous_blend);
+}
+
+bool Profiler::exportChromeTrace(const std::string& path) const {
+    std::ofstream file(path);
+    if (!file.is_open()) {
+        std::cerr << "Error: Could not create trace file: " << path << std::endl;
+        return false;
+    }
+
+    // Trace Event Format: complete events ("X") per frame and phase, counters ("C") for Box2D.
+    // Timestamps are microseconds; fixed notation keeps long sessions from going to exponents
+    file << std::fixed << std::setprecision(3);
+    file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    file << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,\"args\":{\"name\":\"Game loop\"}}";
+    for (int age = recorded_frames_ - 1; age >= 0; --age) {
+        const Frame& frame = frameAt(age);
+        file << ",\n{\"name\":\"Frame\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":" << frame.start_us
+             << ",\"dur\":" << frame.duration_us << ",\"args\":{\"physics_steps\":" << frame.physics_steps << "}}";
+        for (int i = 0; i < frame.span_count; ++i) {
+            const Span& span = frame.spans[i];
+            file << ",\n{\"name\":\"" << PHASE_NAMES[static_cast<int>(span.phase)] << "\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":"
+                 << frame.start_us + span.start_us << ",\"dur\":" << span.duration_us << "}";
+        }
+        if (frame.physics_steps > 0) {
+            file << ",\n{\"name\":\"b2World_Step (ms)\",\"ph\":\"C\",\"pid\":1,\"ts\":" << frame.start_us
+                 << ",\"args\":{\"pairs\":" << frame.box2d.pairs << ",\"collide\":" << frame.box2d.collide
+                 << ",\"solve\":" << frame.box2d.solve << ",\"refit\":" << frame.box2d.refit
+                 << ",\"sensors\":" << frame.box2d.sensors
+                 << ",\"other\":" << std::max(0.0f, frame.box2d.step - frame.box2d.pairs - frame.box2d.collide -
+                                                     frame.box2d.solve - frame.box2d.refit - frame.box2d.sensors)
+                 << "}}";
+        }
+    }
+    file << "\n]}\n";
+
+    if (!file.good()) {
+        std::cerr << "Error: Failed writing trace file: " << path << std::endl;
+        return false;
+    }
+    std::cout << "Wrote " << recorded_frames_ << " frames to trace " << path << std::endl;
+    return true;
+}
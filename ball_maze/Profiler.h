@@ -0,0 +1,103 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <SDL2/SDL.h>
+#include <box2d/box2d.h>
+#include <chrono>
+#include <string>
+#include <vector>
+
+// Parts of a frame that get their own timer. Physics runs inside Update.
+enum class ProfilePhase {
+    INPUT,
+    UPDATE,
+    PHYSICS, // One span per b2World_Step
+    RENDER,
+    COUNT
+};
+
+// Frame timings for the last HISTORY_FRAMES frames, kept in a ring buffer. Game::run times
+// each phase with a ScopedTimer. The history can be drawn as a graph over the game (F3) or
+// saved as a Chrome trace (F4), which opens in chrome://tracing or ui.perfetto.dev.
+class Profiler {
+public:
+    static constexpr int HISTORY_FRAMES = 600;   // 10 s at 60 fps
+    static constexpr int MAX_SPANS_PER_FRAME = 16;
+
+    Profiler();
+
+    void beginFrame();
+    void endFrame();
+
+    // Box2D's own breakdown of the b2World_Step that just ran (b2World_GetProfile); summed
+    // per frame, since a frame may take several steps
+    void addBox2DProfile(const b2Profile& profile);
+
+    // Draws the recent frames as stacked bars (input, update, physics, render) in the
+    // given screen rectangle, with lines at 60 and 30 fps
+    void renderOverlay(SDL_Renderer* renderer, const SDL_Rect& area) const;
+
+    bool exportChromeTrace(const std::string& path) const;
+
+    // Average of the recorded frames in milliseconds, for a text readout
+    float getAverageFrameMs() const;
+    float getAveragePhaseMs(ProfilePhase phase) const;
+
+private:
+    friend class ScopedTimer;
+    using Clock = std::chrono::steady_clock;
+
+    struct Span {
+        ProfilePhase phase;
+        float start_us; // From the start of the frame
+        float duration_us;
+    };
+
+    // Box2D step breakdown, summed over the frame's steps, in milliseconds
+    struct Box2DTimes {
+        float step = 0.0f;
+        float pairs = 0.0f;
+        float collide = 0.0f;
+        float solve = 0.0f;
+        float refit = 0.0f;
+        float sensors = 0.0f;
+    };
+
+    struct Frame {
+        double start_us = 0.0; // Since the profiler was created
+        float duration_us = 0.0f;
+        float phase_us[static_cast<int>(ProfilePhase::COUNT)] = {};
+        Span spans[MAX_SPANS_PER_FRAME];
+        int span_count = 0;
+        int physics_steps = 0;
+        Box2DTimes box2d;
+    };
+
+    void addSpan(ProfilePhase phase, Clock::time_point start, Clock::time_point end);
+    const Frame& frameAt(int age) const; // 0 is the newest finished frame
+
+    Clock::time_point epoch_;
+    Clock::time_point frame_start_;
+    bool in_frame_ = false;
+    std::vector<Frame> frames_;
+    int next_frame_ = 0;     // Ring buffer slot of the frame being recorded
+    int recorded_frames_ = 0;
+};
+
+// Adds the time from construction to destruction to a phase of the current frame
+class ScopedTimer {
+public:
+    ScopedTimer(Profiler& profiler, ProfilePhase phase)
+        : profiler_(profiler), phase_(phase), start_(Profiler::Clock::now()) {}
+    ~ScopedTimer() { profiler_.addSpan(phase_, start_, Profiler::Clock::now()); }
+
+private:
+    Profiler& profiler_;
+    ProfilePhase phase_;
+    Profiler::Clock::time_point start_;
+
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+};
+
+#endif // PROFILER_H
@@ -0,0 +1,274 @@
+#include "Replay.h"
+#include <cstring>
+#include <iostream>
+#include <iterator>
+
+namespace {
+
+const char REPLAY_MAGIC[4] = {'B', 'M', 'R', 'P'};
+const uint32_t REPLAY_VERSION = 2;
+const uint32_t REPLAY_VERSION_FIXED_STEP = 1; // Before adaptive physics; still played back
+
+const unsigned HEADER_ADAPTIVE_PHYSICS = 0x1;
+
+const unsigned FLAG_INPUT_MASK = 0x3;
+const unsigned FLAG_RESET = 0x4;
+const unsigned FLAG_DELTA = 0x8;
+const unsigned RUN_SHIFT = 4;
+
+void writeVarint(std::ostream& out, uint64_t value) {
+    while (value >= 0x80) {
+        out.put(static_cast<char>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    out.put(static_cast<char>(value));
+}
+
+void writeFloat(std::ostream& out, float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    for (int i = 0; i < 4; ++i) {
+        out.put(static_cast<char>((bits >> (8 * i)) & 0xFF));
+    }
+}
+
+bool sameBits(float a, float b) {
+    return std::memcmp(&a, &b, sizeof(float)) == 0;
+}
+
+unsigned encodeInput(int rotation_input) {
+    return rotation_input < 0 ? 1u : (rotation_input > 0 ? 2u : 0u);
+}
+
+int decodeInput(unsigned code) {
+    return code == 1 ? -1 : (code == 2 ? 1 : 0);
+}
+
+// Bounds-checked cursor over the file contents
+struct Cursor {
+    const std::string& bytes;
+    size_t& position;
+
+    bool varint(uint64_t& value) {
+        value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            if (position >= bytes.size()) {
+                return false;
+            }
+            unsigned char byte = static_cast<unsigned char>(bytes[position++]);
+            value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool fixed(uint64_t& value, int size) {
+        if (bytes.size() - position < static_cast<size_t>(size)) {
+            return false;
+        }
+        value = 0;
+        for (int i = 0; i < size; ++i) {
+            value |= static_cast<uint64_t>(static_cast<unsigned char>(bytes[position++])) << (8 * i);
+        }
+        return true;
+    }
+
+    bool real(float& value) {
+        uint64_t bits;
+        if (!fixed(bits, 4)) {
+            return false;
+        }
+        uint32_t bits32 = static_cast<uint32_t>(bits);
+        std::memcpy(&value, &bits32, sizeof(value));
+        return true;
+    }
+};
+
+} // namespace
+
+ReplayWriter::~ReplayWriter() {
+    if (file_.is_open()) {
+        flushRun(); // Unfinished recording: keep the frames, the reader copes without a footer
+    }
+}
+
+bool ReplayWriter::open(const std::string& path, const std::string& level_pack_path, int level_index,
+                        bool adaptive_physics) {
+    file_.open(path, std::ios::binary | std::ios::trunc);
+    if (!file_.is_open()) {
+        std::cerr << "Error: Could not create replay file: " << path << std::endl;
+        return false;
+    }
+    path_ = path;
+    run_length_ = 0;
+    last_delta_time_ = 0.0f;
+    frame_count_ = 0;
+
+    file_.write(REPLAY_MAGIC, sizeof(REPLAY_MAGIC));
+    writeVarint(file_, REPLAY_VERSION);
+    writeVarint(file_, level_pack_path.size());
+    file_.write(level_pack_path.data(), level_pack_path.size());
+    writeVarint(file_, static_cast<uint64_t>(level_index));
+    writeVarint(file_, adaptive_physics ? HEADER_ADAPTIVE_PHYSICS : 0);
+    return file_.good();
+}
+
+void ReplayWriter::addFrame(const ReplayFrame& frame) {
+    if (!file_.is_open()) {
+        return;
+    }
+    frame_count_++;
+
+    // A reset only ever applies to the first frame of a run
+    if (run_length_ > 0 && !frame.reset && frame.rotation_input == run_frame_.rotation_input &&
+        sameBits(frame.delta_time, run_frame_.delta_time)) {
+        run_length_++;
+        return;
+    }
+    flushRun();
+    run_frame_ = frame;
+    run_length_ = 1;
+}
+
+void ReplayWriter::flushRun() {
+    if (run_length_ == 0) {
+        return;
+    }
+    unsigned flags = encodeInput(run_frame_.rotation_input);
+    if (run_frame_.reset) {
+        flags |= FLAG_RESET;
+    }
+    bool delta_changed = !sameBits(run_frame_.delta_time, last_delta_time_);
+    if (delta_changed) {
+        flags |= FLAG_DELTA;
+    }
+
+    writeVarint(file_, (run_length_ << RUN_SHIFT) | flags);
+    if (delta_changed) {
+        writeFloat(file_, run_frame_.delta_time);
+        last_delta_time_ = run_frame_.delta_time;
+    }
+    run_length_ = 0;
+}
+
+bool ReplayWriter::finish(const ReplaySummary& summary) {
+    if (!file_.is_open()) {
+        return false;
+    }
+    flushRun();
+    writeVarint(file_, 0); // End of frames
+    writeVarint(file_, frame_count_);
+    writeVarint(file_, summary.step_count);
+    for (int i = 0; i < 8; ++i) {
+        file_.put(static_cast<char>((summary.state_hash >> (8 * i)) & 0xFF));
+    }
+    file_.put(summary.level_won ? 1 : 0);
+
+    bool ok = file_.good();
+    file_.close();
+    if (!ok) {
+        std::cerr << "Error: Failed writing replay file: " << path_ << std::endl;
+    }
+    return ok;
+}
+
+bool ReplayReader::open(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        std::cerr << "Error: Could not open replay file: " << path << std::endl;
+        return false;
+    }
+    bytes_.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    position_ = 0;
+    run_left_ = 0;
+    ended_ = false;
+    has_summary_ = false;
+    summary_ = ReplaySummary();
+
+    Cursor cursor = {bytes_, position_};
+    uint64_t version = 0;
+    uint64_t path_length = 0;
+    uint64_t level_index = 0;
+    if (bytes_.size() < sizeof(REPLAY_MAGIC) || std::memcmp(bytes_.data(), REPLAY_MAGIC, sizeof(REPLAY_MAGIC)) != 0) {
+        std::cerr << "Error: Not a replay file: " << path << std::endl;
+        return false;
+    }
+    position_ = sizeof(REPLAY_MAGIC);
+    if (!cursor.varint(version) || (version != REPLAY_VERSION && version != REPLAY_VERSION_FIXED_STEP)) {
+        std::cerr << "Error: Unsupported replay version in " << path << std::endl;
+        return false;
+    }
+    if (!cursor.varint(path_length) || bytes_.size() - position_ < path_length) {
+        std::cerr << "Error: Truncated replay header in " << path << std::endl;
+        return false;
+    }
+    level_pack_path_ = bytes_.substr(position_, path_length);
+    position_ += path_length;
+    if (!cursor.varint(level_index)) {
+        std::cerr << "Error: Truncated replay header in " << path << std::endl;
+        return false;
+    }
+    level_index_ = static_cast<int>(level_index);
+    uint64_t header_flags = 0;
+    if (version >= REPLAY_VERSION && !cursor.varint(header_flags)) {
+        std::cerr << "Error: Truncated replay header in " << path << std::endl;
+        return false;
+    }
+    adaptive_physics_ = (header_flags & HEADER_ADAPTIVE_PHYSICS) != 0;
+
+    // Walk the runs once to reach the footer, then rewind to the first frame
+    size_t frames_start = position_;
+    uint64_t frames_seen = 0;
+    while (readRun()) {
+        frames_seen += run_left_;
+    }
+    if (ended_) {
+        uint64_t won = 0;
+        has_summary_ = cursor.varint(summary_.frame_count) && cursor.varint(summary_.step_count) &&
+                       cursor.fixed(summary_.state_hash, 8) && cursor.fixed(won, 1) &&
+                       summary_.frame_count == frames_seen;
+        summary_.level_won = won != 0;
+    }
+    if (!has_summary_) {
+        std::cout << "Warning: Replay " << path << " has no valid summary (recording cut short?)" << std::endl;
+    }
+
+    position_ = frames_start;
+    run_left_ = 0;
+    run_frame_ = ReplayFrame();
+    ended_ = false;
+    return true;
+}
+
+bool ReplayReader::readRun() {
+    if (ended_) {
+        return false;
+    }
+    Cursor cursor = {bytes_, position_};
+    uint64_t header = 0;
+    if (!cursor.varint(header) || header == 0) {
+        ended_ = true; // Either the end marker or a file cut short
+        return false;
+    }
+
+    run_left_ = header >> RUN_SHIFT;
+    run_frame_.rotation_input = decodeInput(header & FLAG_INPUT_MASK);
+    run_frame_.reset = (header & FLAG_RESET) != 0;
+    if ((header & FLAG_DELTA) && !cursor.real(run_frame_.delta_time)) {
+        ended_ = true;
+        return false;
+    }
+    return run_left_ > 0;
+}
+
+bool ReplayReader::nextFrame(ReplayFrame& frame) {
+    if (run_left_ == 0 && !readRun()) {
+        return false;
+    }
+    frame = run_frame_;
+    run_frame_.reset = false; // Only the first frame of a run carries the reset
+    run_left_--;
+    return true;
+}
@@ -0,0 +1,83 @@
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+
+// What updateGameplay() consumed in one frame. Replaying the same frames into a freshly
+// built level reproduces the run exactly, since Box2D is deterministic for identical input.
+struct ReplayFrame {
+    float delta_time = 0.0f;
+    int rotation_input = 0; // -1 left key, 1 right key, 0 none (before the reverse item flips it)
+    bool reset = false;     // 'r' pressed this frame
+};
+
+// How the recorded run ended. A replay is exact when it ends with the same step count and
+// the same state hash (see Game::hashSimulationState).
+struct ReplaySummary {
+    uint64_t frame_count = 0;
+    uint64_t step_count = 0;
+    uint64_t state_hash = 0;
+    bool level_won = false;
+};
+
+// File layout ("BMRP", version 2, integers are LEB128 varints, floats little-endian):
+//   magic, version, level pack path (length + bytes), level index, header flags
+//         header flags: bit 0 adaptive physics (version 1 files have no flags: fixed steps)
+//   runs: varint (frames << 4 | flags), then the new delta_time if flags has DELTA
+//         flags: bits 0-1 input (0 none, 1 left, 2 right), bit 2 reset, bit 3 DELTA
+//   a zero run ends the frames, followed by frame count, step count, u64 state hash, won
+// A run is a stretch of frames with the same input and delta_time. Frames are 60 per second
+// and inputs change rarely, so a minute of play is usually well under a kilobyte.
+class ReplayWriter {
+public:
+    ~ReplayWriter();
+
+    bool open(const std::string& path, const std::string& level_pack_path, int level_index,
+              bool adaptive_physics);
+    void addFrame(const ReplayFrame& frame);
+    bool finish(const ReplaySummary& summary); // Writes the footer and closes the file
+    bool isOpen() const { return file_.is_open(); }
+    const std::string& getPath() const { return path_; }
+
+private:
+    void flushRun();
+
+    std::ofstream file_;
+    std::string path_;
+    ReplayFrame run_frame_;   // State of the pending run
+    uint64_t run_length_ = 0; // Frames in the pending run, 0 when there is none
+    float last_delta_time_ = 0.0f; // delta_time of the last run written
+    uint64_t frame_count_ = 0;
+};
+
+class ReplayReader {
+public:
+    bool open(const std::string& path);
+
+    const std::string& getLevelPackPath() const { return level_pack_path_; }
+    int getLevelIndex() const { return level_index_; }
+    bool isAdaptivePhysics() const { return adaptive_physics_; } // How the run was stepped, see Game::setAdaptivePhysics
+    bool hasSummary() const { return has_summary_; } // False for a file cut short by a crash
+    const ReplaySummary& getSummary() const { return summary_; }
+
+    bool nextFrame(ReplayFrame& frame); // False once every recorded frame has been returned
+
+private:
+    bool readRun();
+
+    std::string bytes_;
+    size_t position_ = 0;
+    std::string level_pack_path_;
+    int level_index_ = 0;
+    bool adaptive_physics_ = false;
+    ReplayFrame run_frame_;
+    uint64_t run_left_ = 0;
+    bool ended_ = false;
+    bool has_summary_ = false;
+    ReplaySummary summary_;
+};
+
+#endif // REPLAY_H
@@ -4,19 +4,22 @@
 #include <SDL2/SDL.h>
 #include <box2d/box2d.h>
 #include "constants.h"
+#include "BatchRenderer.h"
 
 class ReverseItem {
 public:
     static const float MAX_COOLDOWN_SECONDS;
 
-    ReverseItem(b2WorldId worldId);
+    // The item rides on the maze body; its trigger is a maze sensor created by Game
+    ReverseItem(b2BodyId maze_body_id);
     ~ReverseItem();
 
-    void create(b2Vec2 position_meters, float size_meters);
-    void render(SDL_Renderer* renderer, float camera_offset_x, float camera_offset_y, b2Vec2 rotated_position = {0, 0}) const;
+    void create(b2Vec2 local_position_meters, float size_meters);
+    // Placed with the same maze transform the maze was drawn with, so it can't drift off its tile
+    void render(BatchRenderer& batch, const b2Transform& maze_transform, float camera_offset_x, float camera_offset_y) const;
     
-    b2BodyId getBodyId() const;
-    b2Vec2 getPosition() const; // In meters
+    b2Vec2 getPosition() const; // World position in meters, follows the maze rotation
+    b2Vec2 getLocalPosition() const { return local_position_; } // Position in maze body coordinates
     
     // Check if the item is active (not yet collected/triggered)
     bool isActive() const;
@@ -43,8 +46,8 @@ public:
     void deactivate();
 
 private:
-    b2WorldId worldId_;
-    b2BodyId bodyId_;
+    b2BodyId maze_body_id_;
+    b2Vec2 local_position_;
     float sizeMeters_;
     bool active_;    // Whether the item is active and can be collected
     float current_cooldown_seconds_; // Time remaining for cooldown
@@ -0,0 +1,64 @@
+#include "SpatialGrid.h"
+#include <algorithm>
+#include <cmath>
+
+void SpatialGrid::reset(b2AABB bounds, float cell_size) {
+    bounds_ = bounds;
+    cell_size_ = cell_size > 0.0f ? cell_size : 1.0f;
+    columns_ = std::max(1, static_cast<int>(std::ceil((bounds.upperBound.x - bounds.lowerBound.x) / cell_size_)));
+    rows_ = std::max(1, static_cast<int>(std::ceil((bounds.upperBound.y - bounds.lowerBound.y) / cell_size_)));
+    cells_.assign(static_cast<size_t>(columns_) * rows_, std::vector<int>());
+    object_count_ = 0;
+    seen_.clear();
+    query_stamp_ = 0;
+}
+
+int SpatialGrid::columnOf(float x) const {
+    int column = static_cast<int>(std::floor((x - bounds_.lowerBound.x) / cell_size_));
+    return std::max(0, std::min(column, columns_ - 1));
+}
+
+int SpatialGrid::rowOf(float y) const {
+    int row = static_cast<int>(std::floor((y - bounds_.lowerBound.y) / cell_size_));
+    return std::max(0, std::min(row, rows_ - 1));
+}
+
+void SpatialGrid::insert(int id, b2AABB box) {
+    if (cells_.empty() || id < 0) {
+        return;
+    }
+    // Rounding at the edges is clamped into the border cells
+    for (int row = rowOf(box.lowerBound.y); row <= rowOf(box.upperBound.y); ++row) {
+        for (int column = columnOf(box.lowerBound.x); column <= columnOf(box.upperBound.x); ++column) {
+            cells_[static_cast<size_t>(row) * columns_ + column].push_back(id);
+        }
+    }
+    if (static_cast<size_t>(id) >= seen_.size()) {
+        seen_.resize(id + 1, 0);
+    }
+    object_count_++;
+}
+
+void SpatialGrid::query(b2AABB box, std::vector<int>& ids) const {
+    ids.clear();
+    if (cells_.empty() || box.upperBound.x < bounds_.lowerBound.x || box.lowerBound.x > bounds_.upperBound.x ||
+        box.upperBound.y < bounds_.lowerBound.y || box.lowerBound.y > bounds_.upperBound.y) {
+        return;
+    }
+
+    if (++query_stamp_ == 0) {
+        std::fill(seen_.begin(), seen_.end(), 0); // Stamp wrapped around
+        query_stamp_ = 1;
+    }
+    for (int row = rowOf(box.lowerBound.y); row <= rowOf(box.upperBound.y); ++row) {
+        for (int column = columnOf(box.lowerBound.x); column <= columnOf(box.upperBound.x); ++column) {
+            for (int id : cells_[static_cast<size_t>(row) * columns_ + column]) {
+                if (seen_[id] != query_stamp_) {
+                    seen_[id] = query_stamp_;
+                    ids.push_back(id);
+                }
+            }
+        }
+    }
+    std::sort(ids.begin(), ids.end()); // Same draw order as drawing everything
+}
@@ -0,0 +1,41 @@
+#ifndef SPATIAL_GRID_H
+#define SPATIAL_GRID_H
+
+#include <box2d/box2d.h>
+#include <cstdint>
+#include <vector>
+
+// Uniform grid over a fixed area for objects that don't move relative to it, such as the
+// walls and items in maze body coordinates. An object is listed in every cell its bounds
+// touch; query() returns the objects whose cells overlap a box, so callers draw what is
+// near the viewport instead of the whole level.
+class SpatialGrid {
+public:
+    // Clears the grid and covers `bounds` with square cells of `cell_size`
+    void reset(b2AABB bounds, float cell_size);
+
+    // ids are small non-negative integers, normally the object's index in its container.
+    // box should lie within the bounds given to reset().
+    void insert(int id, b2AABB box);
+
+    // Replaces `ids` with every object that may overlap `box`, each once, in ascending order
+    void query(b2AABB box, std::vector<int>& ids) const;
+
+    int getObjectCount() const { return object_count_; }
+
+private:
+    int columnOf(float x) const;
+    int rowOf(float y) const;
+
+    b2AABB bounds_ = {{0.0f, 0.0f}, {0.0f, 0.0f}};
+    float cell_size_ = 1.0f;
+    int columns_ = 0;
+    int rows_ = 0;
+    int object_count_ = 0;
+    std::vector<std::vector<int>> cells_;
+    // Last query that returned each id, so an object spanning several cells is reported once
+    mutable std::vector<uint32_t> seen_;
+    mutable uint32_t query_stamp_ = 0;
+};
+
+#endif // SPATIAL_GRID_H
@@ -0,0 +1,184 @@
+#include "TaskScheduler.h"
+#include <algorithm>
+
+namespace {
+
+const int MAX_WORKERS = 64;                // Box2D's B2_MAX_WORKERS
+const int TARGET_CHUNKS_PER_WORKER = 4;    // Enough slack for stealing to even out uneven chunks
+const int IDLE_SPINS_BEFORE_SLEEP = 256;   // Solver stages arrive back to back within a step
+
+} // namespace
+
+TaskScheduler::TaskScheduler(int worker_count) : worker_count_(resolveWorkerCount(worker_count)) {
+    int thread_count = worker_count_ - 1;
+    for (int i = 0; i < thread_count; ++i) {
+        queues_.push_back(std::make_unique<WorkerQueue>());
+    }
+    for (int i = 0; i < thread_count; ++i) {
+        threads_.emplace_back(&TaskScheduler::workerLoop, this, i);
+    }
+}
+
+TaskScheduler::~TaskScheduler() {
+    stopping_ = true;
+    {
+        std::lock_guard<std::mutex> lock(wake_mutex_);
+    }
+    wake_condition_.notify_all();
+    for (auto& thread : threads_) {
+        thread.join();
+    }
+}
+
+int TaskScheduler::resolveWorkerCount(int requested) {
+    int count = requested;
+    if (count <= 0) {
+        count = static_cast<int>(std::thread::hardware_concurrency());
+    }
+    return std::max(1, std::min(count, MAX_WORKERS));
+}
+
+void TaskScheduler::configureWorld(b2WorldDef& world_def) {
+    world_def.workerCount = worker_count_;
+    if (worker_count_ > 1) {
+        world_def.enqueueTask = &TaskScheduler::enqueueTask;
+        world_def.finishTask = &TaskScheduler::finishTask;
+        world_def.userTaskContext = this;
+    }
+}
+
+void* TaskScheduler::enqueueTask(b2TaskCallback* callback, int item_count, int min_range, void* task_context, void* user_context) {
+    TaskScheduler* scheduler = static_cast<TaskScheduler*>(user_context);
+    if (item_count <= 0) {
+        return nullptr; // Nothing to run; Box2D skips finishTask for a null handle
+    }
+
+    int target_chunks = scheduler->worker_count_ * TARGET_CHUNKS_PER_WORKER;
+    int chunk_size = std::max(std::max(min_range, 1), (item_count + target_chunks - 1) / target_chunks);
+    int chunk_count = (item_count + chunk_size - 1) / chunk_size;
+
+    Task* task = scheduler->acquireTask();
+    task->callback = callback;
+    task->context = task_context;
+    task->chunks_left.store(chunk_count, std::memory_order_relaxed);
+
+    // Count before publishing so a thief never sees the counter lag behind the queues.
+    // Chunks are dealt round-robin; only the stepping thread enqueues, so next_queue_ needs no lock.
+    scheduler->queued_chunks_.fetch_add(chunk_count);
+    int queue_count = static_cast<int>(scheduler->queues_.size());
+    for (int start = 0; start < item_count; start += chunk_size) {
+        WorkerQueue& queue = *scheduler->queues_[scheduler->next_queue_];
+        scheduler->next_queue_ = (scheduler->next_queue_ + 1) % queue_count;
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.chunks.push_back({task, start, std::min(start + chunk_size, item_count)});
+    }
+
+    // Taking the mutex orders this notify after any sleeper's predicate check
+    {
+        std::lock_guard<std::mutex> lock(scheduler->wake_mutex_);
+    }
+    scheduler->wake_condition_.notify_all();
+    return task;
+}
+
+void TaskScheduler::finishTask(void* user_task, void* user_context) {
+    TaskScheduler* scheduler = static_cast<TaskScheduler*>(user_context);
+    Task* task = static_cast<Task*>(user_task);
+
+    // Help out instead of blocking. Chunks of other tasks are fine to run here too.
+    while (task->chunks_left.load(std::memory_order_acquire) > 0) {
+        Chunk chunk;
+        if (scheduler->popOrSteal(-1, chunk)) {
+            scheduler->runChunk(chunk, 0);
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    scheduler->releaseTask(task);
+}
+
+void TaskScheduler::workerLoop(int queue_index) {
+    uint32_t worker_index = static_cast<uint32_t>(queue_index + 1);
+    int idle_spins = 0;
+
+    while (true) {
+        Chunk chunk;
+        if (popOrSteal(queue_index, chunk)) {
+            runChunk(chunk, worker_index);
+            idle_spins = 0;
+            continue;
+        }
+
+        if (idle_spins < IDLE_SPINS_BEFORE_SLEEP) {
+            idle_spins++;
+            std::this_thread::yield();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(wake_mutex_);
+        wake_condition_.wait(lock, [this] { return stopping_ || queued_chunks_.load() > 0; });
+        if (stopping_ && queued_chunks_.load() == 0) {
+            return;
+        }
+        idle_spins = 0;
+    }
+}
+
+bool TaskScheduler::popOrSteal(int queue_index, Chunk& chunk) {
+    if (queued_chunks_.load() <= 0) {
+        return false;
+    }
+
+    // Own queue from the back, most recently dealt chunk first
+    if (queue_index >= 0) {
+        WorkerQueue& own = *queues_[queue_index];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.chunks.empty()) {
+            chunk = own.chunks.back();
+            own.chunks.pop_back();
+            queued_chunks_.fetch_sub(1);
+            return true;
+        }
+    }
+
+    // Steal from the front of everyone else's
+    int queue_count = static_cast<int>(queues_.size());
+    int first = queue_index >= 0 ? queue_index + 1 : 0;
+    for (int i = 0; i < queue_count; ++i) {
+        int victim = (first + i) % queue_count;
+        if (victim == queue_index) {
+            continue;
+        }
+        WorkerQueue& queue = *queues_[victim];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.chunks.empty()) {
+            chunk = queue.chunks.front();
+            queue.chunks.pop_front();
+            queued_chunks_.fetch_sub(1);
+            return true;
+        }
+    }
+    return false;
+}
+
+void TaskScheduler::runChunk(const Chunk& chunk, uint32_t worker_index) {
+    Task* task = chunk.task;
+    task->callback(chunk.start, chunk.end, worker_index, task->context);
+    task->chunks_left.fetch_sub(1, std::memory_order_release); // Last touch; finishTask may recycle the task now
+}
+
+TaskScheduler::Task* TaskScheduler::acquireTask() {
+    std::lock_guard<std::mutex> lock(free_tasks_mutex_);
+    if (free_tasks_.empty()) {
+        all_tasks_.push_back(std::make_unique<Task>());
+        return all_tasks_.back().get();
+    }
+    Task* task = free_tasks_.back();
+    free_tasks_.pop_back();
+    return task;
+}
+
+void TaskScheduler::releaseTask(Task* task) {
+    std::lock_guard<std::mutex> lock(free_tasks_mutex_);
+    free_tasks_.push_back(task);
+}
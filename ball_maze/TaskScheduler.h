@@ -0,0 +1,81 @@
+#ifndef TASK_SCHEDULER_H
+#define TASK_SCHEDULER_H
+
+#include <box2d/box2d.h>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Work-stealing thread pool that runs Box2D's parallel solver stages.
+//
+// Box2D hands over each parallel-for through the b2WorldDef enqueueTask callback. The item
+// range is cut into chunks that are spread over the per-thread queues; a thread works
+// through its own queue from the back and steals from the front of the others when it runs
+// dry. The thread that calls b2World_Step is worker 0: it helps run chunks while it waits
+// in finishTask, and pool thread i reports worker index i + 1.
+class TaskScheduler {
+public:
+    // worker_count counts the stepping thread too, so 1 means no pool threads at all
+    explicit TaskScheduler(int worker_count);
+    ~TaskScheduler();
+
+    int getWorkerCount() const { return worker_count_; }
+
+    // Points the world definition at this scheduler. With one worker Box2D is left on its
+    // built-in single-threaded path. The scheduler must outlive the world.
+    void configureWorld(b2WorldDef& world_def);
+
+    // hardware_concurrency, clamped to what Box2D supports. 0 means "pick for me".
+    static int resolveWorkerCount(int requested);
+
+private:
+    struct Task {
+        b2TaskCallback* callback = nullptr;
+        void* context = nullptr;
+        std::atomic<int> chunks_left{0};
+    };
+
+    struct Chunk {
+        Task* task;
+        int start;
+        int end;
+    };
+
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<Chunk> chunks;
+    };
+
+    static void* enqueueTask(b2TaskCallback* task, int item_count, int min_range, void* task_context, void* user_context);
+    static void finishTask(void* user_task, void* user_context);
+
+    void workerLoop(int queue_index);
+    bool popOrSteal(int queue_index, Chunk& chunk); // queue_index -1 only steals
+    void runChunk(const Chunk& chunk, uint32_t worker_index);
+    Task* acquireTask();
+    void releaseTask(Task* task);
+
+    int worker_count_;
+    std::vector<std::unique_ptr<WorkerQueue>> queues_; // One per pool thread
+    std::vector<std::thread> threads_;
+    int next_queue_ = 0;
+
+    std::atomic<int> queued_chunks_{0};
+    std::atomic<bool> stopping_{false};
+    std::mutex wake_mutex_;
+    std::condition_variable wake_condition_;
+
+    std::mutex free_tasks_mutex_;
+    std::vector<std::unique_ptr<Task>> all_tasks_;
+    std::vector<Task*> free_tasks_;
+
+    TaskScheduler(const TaskScheduler&) = delete;
+    TaskScheduler& operator=(const TaskScheduler&) = delete;
+};
+
+#endif // TASK_SCHEDULER_H
@@ -0,0 +1,72 @@
+#include "TextCache.h"
+#include <functional>
+#include <iostream>
+
+size_t TextCache::KeyHash::operator()(const Key& key) const {
+    size_t hash = std::hash<std::string>()(key.text);
+    hash ^= std::hash<const void*>()(key.font) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    hash ^= std::hash<Uint32>()(key.color) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    hash ^= std::hash<int>()(key.wrap_width) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    return hash;
+}
+
+TextCache::TextCache(size_t capacity) : capacity_(capacity > 0 ? capacity : 1) {
+}
+
+TextCache::~TextCache() {
+    clear();
+}
+
+const TextTexture* TextCache::get(SDL_Renderer* renderer, TTF_Font* font, const std::string& text,
+                                  SDL_Color color, int wrap_width) {
+    if (!renderer || !font || text.empty()) {
+        return nullptr;
+    }
+
+    Key key = {font, text,
+               (static_cast<Uint32>(color.r) << 24) | (static_cast<Uint32>(color.g) << 16) |
+               (static_cast<Uint32>(color.b) << 8) | static_cast<Uint32>(color.a),
+               wrap_width};
+
+    auto found = index_.find(key);
+    if (found != index_.end()) {
+        // Hit: move to the front of the LRU list
+        entries_.splice(entries_.begin(), entries_, found->second);
+        return &found->second->value;
+    }
+
+    SDL_Surface* surface = wrap_width > 0
+        ? TTF_RenderText_Blended_Wrapped(font, text.c_str(), color, wrap_width)
+        : TTF_RenderText_Blended(font, text.c_str(), color);
+    if (!surface) {
+        std::cerr << "Warning: Could not render text '" << text << "': " << TTF_GetError() << std::endl;
+        return nullptr;
+    }
+
+    SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, surface);
+    TextTexture value = {texture, surface->w, surface->h};
+    SDL_FreeSurface(surface);
+    if (!texture) {
+        std::cerr << "Warning: Could not create text texture: " << SDL_GetError() << std::endl;
+        return nullptr;
+    }
+
+    if (entries_.size() >= capacity_) {
+        Entry& oldest = entries_.back();
+        SDL_DestroyTexture(oldest.value.texture);
+        index_.erase(oldest.key);
+        entries_.pop_back();
+    }
+
+    entries_.push_front({key, value});
+    index_[key] = entries_.begin();
+    return &entries_.front().value;
+}
+
+void TextCache::clear() {
+    for (auto& entry : entries_) {
+        SDL_DestroyTexture(entry.value.texture);
+    }
+    entries_.clear();
+    index_.clear();
+}
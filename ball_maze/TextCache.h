@@ -0,0 +1,68 @@
+#ifndef TEXT_CACHE_H
+#define TEXT_CACHE_H
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+#include <cstddef>
+#include <list>
+#include <string>
+#include <unordered_map>
+
+// A rasterized string owned by TextCache
+struct TextTexture {
+    SDL_Texture* texture;
+    int width;
+    int height;
+};
+
+// Keeps the textures of recently drawn strings so unchanged menu and HUD text is not
+// re-rasterized every frame. Entries are keyed by font, string, color and wrap width and
+// the least recently used entry is destroyed once the cache is full.
+class TextCache {
+public:
+    explicit TextCache(size_t capacity = 64);
+    ~TextCache();
+
+    // Returns the texture for this text, rendering it on a miss. nullptr for empty text or
+    // if SDL_ttf fails. The pointer stays valid until the entry is evicted, which can only
+    // happen on a later get(). wrap_width > 0 renders wrapped text.
+    const TextTexture* get(SDL_Renderer* renderer, TTF_Font* font, const std::string& text,
+                           SDL_Color color, int wrap_width = 0);
+
+    // Destroys every cached texture. Needed before the renderer or fonts go away and when
+    // SDL reports the render device was reset.
+    void clear();
+
+    size_t size() const { return entries_.size(); }
+
+private:
+    struct Key {
+        TTF_Font* font;
+        std::string text;
+        Uint32 color; // RGBA packed
+        int wrap_width;
+
+        bool operator==(const Key& other) const {
+            return font == other.font && color == other.color && wrap_width == other.wrap_width && text == other.text;
+        }
+    };
+
+    struct KeyHash {
+        size_t operator()(const Key& key) const;
+    };
+
+    struct Entry {
+        Key key;
+        TextTexture value;
+    };
+
+    size_t capacity_;
+    std::list<Entry> entries_; // Most recently used first
+    std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> index_;
+
+    // Disable copying, entries own SDL textures
+    TextCache(const TextCache&) = delete;
+    TextCache& operator=(const TextCache&) = delete;
+};
+
+#endif // TEXT_CACHE_H
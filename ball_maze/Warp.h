@@ -5,18 +5,19 @@
 #include <SDL2/SDL.h>
 #include <vector>
 #include <memory>
+#include "BatchRenderer.h"
 
 
 
 class Warp {
 public:
-    Warp(b2WorldId worldId, int id, b2Vec2 position, float radius = 0.2f);
+    // The warp rides on the maze body; its trigger is a maze sensor created by Game
+    Warp(b2BodyId maze_body_id, int id, b2Vec2 local_position, float radius = 0.2f);
     ~Warp();
     
-    b2BodyId getBodyId() const { return bodyId_; }
     int getId() const { return id_; }
-    b2Vec2 getPosition() const;
-    b2Vec2 getOriginalPosition() const { return position_; } // Return the original unrotated position
+    b2Vec2 getPosition() const; // Current world position, follows the maze rotation
+    b2Vec2 getLocalPosition() const { return local_position_; } // Position in maze body coordinates
     float getRadius() const { return radius_; }
     SDL_Color getColor() const;
     
@@ -26,19 +27,20 @@ public:
     void updateCooldown(float delta_time);
     void resetCooldown() { is_on_cooldown_ = false; cooldown_timer_ = 0.0f; }
     
-    // Static method to handle warping between pairs
-    static void handleWarpCollision(int warpId, b2BodyId ballBody, const std::vector<std::unique_ptr<Warp>>& warps);
+    // Teleports the ball from sourceWarp to its partner. Returns false if the source is
+    // cooling down or has no partner.
+    static bool handleWarpCollision(Warp* sourceWarp, b2BodyId ballBody, const std::vector<std::unique_ptr<Warp>>& warps);
     
-    void render(SDL_Renderer* renderer, float camera_offset_x, float camera_offset_y, b2Vec2 rotated_position = {0.0f, 0.0f}) const;
+    // maze_transform: the interpolated maze body transform from Maze::getInterpolatedTransform
+    void render(BatchRenderer& batch, const b2Transform& maze_transform, float camera_offset_x, float camera_offset_y) const;
 
     // Cooldown constants
     static constexpr float WARP_COOLDOWN_TIME = 2.0f; // seconds
     
 private:
-    b2WorldId worldId_;
-    b2BodyId bodyId_;
+    b2BodyId maze_body_id_;
     int id_;
-    b2Vec2 position_;
+    b2Vec2 local_position_;
     float radius_;
     
     // Cooldown state
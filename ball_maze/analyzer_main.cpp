@@ -0,0 +1,103 @@
+#include "Level.h"
+#include "MazeAnalyzer.h"
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+static void printUsage(const char* program) {
+    std::cerr << "Usage: " << program << " [options] <level_pack.txt>...\n"
+              << "  --level N     Only analyze level N, 1-based\n"
+              << "  --buckets N   Rotation steps per full turn (default 8, i.e. 45 degrees)\n"
+              << "  --jobs N      Levels analyzed in parallel (default: all cores)\n"
+              << "Exits with 1 when any level is unsolvable.\n";
+}
+
+// Parses every level of a pack up front; analysis then runs on plain LevelData copies
+static bool loadPack(const std::string& path, int only_level, std::vector<LevelData>& levels) {
+    Level level;
+    std::streambuf* saved = std::cout.rdbuf(nullptr); // Level::loadFromFile is chatty
+    bool loaded = level.loadFromFile(path);
+    if (loaded) {
+        for (int i = 0; i < level.getTotalLevels(); ++i) {
+            if (only_level >= 0 && i != only_level) {
+                continue;
+            }
+            const LevelData* data = level.getLevelData(i);
+            if (!data) {
+                loaded = false;
+                break;
+            }
+            levels.push_back(*data);
+        }
+    }
+    std::cout.rdbuf(saved);
+    if (!loaded) {
+        std::cerr << "Error: Could not load level pack: " << path << std::endl;
+    }
+    return loaded;
+}
+
+int main(int argc, char* argv[]) {
+    int only_level = -1;
+    int rotation_buckets = 8;
+    int jobs = 0;
+    std::vector<std::string> pack_paths;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool has_value = i + 1 < argc;
+        if (arg == "--level" && has_value) {
+            only_level = std::atoi(argv[++i]) - 1;
+        } else if (arg == "--buckets" && has_value) {
+            rotation_buckets = std::atoi(argv[++i]);
+        } else if (arg == "--jobs" && has_value) {
+            jobs = std::atoi(argv[++i]);
+        } else if (!arg.empty() && arg[0] != '-') {
+            pack_paths.push_back(arg);
+        } else {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+    if (pack_paths.empty() || rotation_buckets < 4) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    int total_levels = 0;
+    int unsolvable_levels = 0;
+    for (const std::string& path : pack_paths) {
+        std::vector<LevelData> levels;
+        if (!loadPack(path, only_level, levels)) {
+            return 1;
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        std::vector<LevelAnalysis> results = MazeAnalyzer::analyzeAll(levels, rotation_buckets, jobs);
+        double elapsed_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        std::cout << path << ": " << levels.size() << " levels analyzed in "
+                  << std::fixed << std::setprecision(1) << elapsed_ms << " ms" << std::endl;
+        for (size_t i = 0; i < results.size(); ++i) {
+            const LevelAnalysis& result = results[i];
+            int number = only_level >= 0 ? only_level + 1 : static_cast<int>(i) + 1;
+            std::cout << "  " << std::setw(3) << number << "  " << std::left << std::setw(28)
+                      << levels[i].name.substr(0, 27) << std::right;
+            if (result.solvable) {
+                std::cout << "rotations " << std::setw(3) << result.min_rotations
+                          << "  par " << std::setw(5) << result.par_time_seconds << " s";
+            } else {
+                std::cout << "UNSOLVABLE: " << result.problem;
+                unsolvable_levels++;
+            }
+            std::cout << "  (" << result.states_explored << " states)" << std::endl;
+        }
+        total_levels += static_cast<int>(results.size());
+    }
+
+    std::cout << (total_levels - unsolvable_levels) << "/" << total_levels << " levels solvable" << std::endl;
+    return unsolvable_levels > 0 ? 1 : 0;
+}
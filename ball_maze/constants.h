@@ -13,11 +13,23 @@ const float PPM = 32.0f; // Pixels Per Meter
 
 // Physics simulation parameters
 const float MAZE_TARGET_ROTATION_SPEED_DPS = 45.0f; // Target rotation speed in degrees per second (reduced from 90.0f)
+const float WORLD_GRAVITY_Y = 20.0f; // m/s^2, increased for faster movement
+const float BALL_GRAVITY_SCALE = 1.5f; // Balls (and crates) fall faster still
 const float TIME_STEP = 1.0f / 120.0f; // 120 FPS physics for stable simulation
 const int VELOCITY_ITERATIONS = 20; // Increased to match POSITION_ITERATIONS (was 16)
 const int POSITION_ITERATIONS = 20; // Further increased for collision accuracy (was 12)
 const float MAZE_ANIMATION_ROTATION_SPEED_RAD_PER_SEC = M_PI / 2.0f; // Was M_PI (180dps), now 90dps. Aligns better with max physical rotation.
 const float PHYSICS_SHAPE_OVERLAP_METERS = 0.0f;  // Physics shapes match tile size (was 0.05f, which made them smaller)
+// Adaptive stepping (Game::choosePhysicsStep). A step may be 1/4 to 2 TIME_STEPs long and
+// use MIN_SUB_STEPS to POSITION_ITERATIONS sub-steps, as long as nothing moves further than
+// these distances relative to the walls within one step or sub-step.
+const float MAX_STEP_TRAVEL_FRACTION = 0.25f; // Of the smallest ball radius or crate half size
+const float MAX_SUB_STEP_TRAVEL = 0.01f;      // Meters, twice Box2D's linear slop
+const int MIN_SUB_STEPS = 4;
+const float IMPACT_SETTLE_TIME = 0.25f;       // Seconds at the fixed rate after a ball or crate hits something
 const float DISCRETE_ROTATION_STEP_RAD = M_PI / 180.0f * 0.1f; // Drastically reduced step for collision stability (0.1 degrees, was 0.25)
+// Side of a SpatialGrid cell, in tiles (the maze's walls and holes, the game's items). A
+// screen is roughly 20x15 tiles, so a query touches a handful of cells whatever the level size.
+const float GRID_CELL_TILES = 8.0f;
 
 #endif // CONSTANTS_H
@@ -0,0 +1,195 @@
+#include "HeadlessRunner.h"
+#include "Level.h"
+#include "MazeGenerator.h"
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+#include <streambuf>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// Discards everything written to it. Unlike a null rdbuf it never touches the stream state,
+// so games running on several threads can log into it at once.
+class NullBuffer : public std::streambuf {
+protected:
+    int overflow(int c) override { return traits_type::not_eof(c); }
+};
+
+const int MAX_PHYSICS_RETRIES = 20; // Fresh levels tried when the simulation disagrees with the analyzer
+
+struct GeneratedLevel {
+    bool ok = false;
+    LevelData level;
+    LevelAnalysis analysis;
+    int physics_rejections = 0;
+    float simulated_seconds = 0.0f;
+};
+
+} // namespace
+
+static void printUsage(const char* program) {
+    std::cerr << "Usage: " << program << " [options] <output_pack.txt>\n"
+              << "  --count N        Levels in the pack (default 20)\n"
+              << "  --difficulty D   1 to 10 (default 3)\n"
+              << "  --ramp           Raise the difficulty from 1 to D over the pack\n"
+              << "  --size WxH       Grid size (default grows with the difficulty)\n"
+              << "  --holes N, --warps N, --reverse N   Override the difficulty's object counts\n"
+              << "  --seed N         Pack seed (default: from the clock); same seed, same pack\n"
+              << "  --name NAME      Pack name (default \"Generated\")\n"
+              << "  --jobs N         Levels generated in parallel (default: all cores)\n"
+              << "  --no-physics     Only check levels with the analyzer, skip the Box2D run\n";
+}
+
+int main(int argc, char* argv[]) {
+    GeneratorSettings settings;
+    int count = 20;
+    bool ramp = false;
+    uint64_t seed = static_cast<uint64_t>(std::time(nullptr));
+    std::string pack_name = "Generated";
+    int jobs = 0;
+    bool physics_check = true;
+    std::string output_path;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool has_value = i + 1 < argc;
+        if (arg == "--count" && has_value) {
+            count = std::atoi(argv[++i]);
+        } else if (arg == "--difficulty" && has_value) {
+            settings.difficulty = std::atoi(argv[++i]);
+        } else if (arg == "--ramp") {
+            ramp = true;
+        } else if (arg == "--size" && has_value) {
+            std::string size = argv[++i];
+            size_t separator = size.find('x');
+            settings.width = std::atoi(size.c_str());
+            settings.height = separator == std::string::npos ? settings.width : std::atoi(size.c_str() + separator + 1);
+        } else if (arg == "--holes" && has_value) {
+            settings.holes = std::atoi(argv[++i]);
+        } else if (arg == "--warps" && has_value) {
+            settings.warp_pairs = std::atoi(argv[++i]);
+        } else if (arg == "--reverse" && has_value) {
+            settings.reverse_items = std::atoi(argv[++i]);
+        } else if (arg == "--seed" && has_value) {
+            seed = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--name" && has_value) {
+            pack_name = argv[++i];
+        } else if (arg == "--jobs" && has_value) {
+            jobs = std::atoi(argv[++i]);
+        } else if (arg == "--no-physics") {
+            physics_check = false;
+        } else if (!arg.empty() && arg[0] != '-' && output_path.empty()) {
+            output_path = arg;
+        } else {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+    if (output_path.empty() || count <= 0) {
+        printUsage(argv[0]);
+        return 1;
+    }
+    if (jobs <= 0) {
+        jobs = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    }
+    jobs = std::min(jobs, count);
+
+    std::vector<GeneratedLevel> results(count);
+    std::atomic<int> next_level{0};
+    auto worker = [&]() {
+        for (int index = next_level++; index < count; index = next_level++) {
+            GeneratorSettings level_settings = settings;
+            if (ramp && count > 1) {
+                level_settings.difficulty = 1 + (settings.difficulty - 1) * index / (count - 1);
+            }
+            MazeGenerator generator(level_settings);
+            GeneratedLevel& result = results[index];
+
+            // The analyzer's grid model can disagree with the real physics (a ball that
+            // bounces past a corner, a roll cut short by friction); such levels are replaced
+            for (int retry = 0; retry <= MAX_PHYSICS_RETRIES && !result.ok; ++retry) {
+                uint64_t level_seed = MazeGenerator::levelSeed(MazeGenerator::levelSeed(seed, index), retry);
+                if (!generator.generate(level_seed, result.level, result.analysis)) {
+                    break;
+                }
+                result.ok = !physics_check ||
+                    HeadlessRunner::playSolution(result.level, result.analysis.solution, 8, &result.simulated_seconds);
+                if (!result.ok) {
+                    result.physics_rejections++;
+                }
+            }
+            result.level.name = pack_name + " " + std::to_string(index + 1);
+        }
+    };
+
+    auto start = std::chrono::steady_clock::now();
+    {
+        // The games built for the physics check log to std::cout
+        NullBuffer null_buffer;
+        std::streambuf* saved = std::cout.rdbuf(&null_buffer);
+        std::vector<std::thread> threads;
+        for (int i = 1; i < jobs; ++i) {
+            threads.emplace_back(worker);
+        }
+        worker();
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        std::cout.rdbuf(saved);
+    }
+    double elapsed_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::vector<LevelData> levels;
+    int failed = 0;
+    int physics_rejections = 0;
+    std::cout << std::fixed << std::setprecision(1);
+    for (int i = 0; i < count; ++i) {
+        const GeneratedLevel& result = results[i];
+        physics_rejections += result.physics_rejections;
+        std::cout << "  " << std::setw(3) << (i + 1) << "  ";
+        if (!result.ok) {
+            std::cout << "FAILED (no level passed the checks)" << std::endl;
+            failed++;
+            continue;
+        }
+        std::cout << std::left << std::setw(7) << result.level.difficulty << std::right
+                  << result.level.width << "x" << result.level.height
+                  << "  rotations " << std::setw(3) << result.analysis.min_rotations
+                  << "  par " << std::setw(5) << result.analysis.par_time_seconds << " s";
+        if (physics_check) {
+            std::cout << "  Box2D won in " << result.simulated_seconds << " s";
+        }
+        std::cout << std::endl;
+        levels.push_back(result.level);
+    }
+    std::cout << levels.size() << "/" << count << " levels in " << std::setprecision(2) << elapsed_seconds
+              << " s with " << jobs << " thread(s), seed " << seed;
+    if (physics_check) {
+        std::cout << ", " << physics_rejections << " rejected by the Box2D check";
+    }
+    std::cout << std::endl;
+
+    if (levels.empty()) {
+        return 1;
+    }
+
+    char date[16];
+    std::time_t now = std::time(nullptr);
+    std::strftime(date, sizeof(date), "%Y-%m-%d", std::localtime(&now));
+    LevelPackInfo pack_info;
+    pack_info.name = pack_name;
+    pack_info.description = "Generated with seed " + std::to_string(seed);
+    pack_info.author = "ball_maze_generator";
+    pack_info.date = date;
+    if (!Level::saveToFile(output_path, pack_info, levels)) {
+        return 1;
+    }
+    std::cout << "Wrote " << output_path << std::endl;
+    return failed > 0 ? 1 : 0;
+}
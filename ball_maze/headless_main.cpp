@@ -0,0 +1,61 @@
+#include "HeadlessRunner.h"
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+static void printUsage(const char* program) {
+    std::cerr << "Usage: " << program << " [options] <level_pack.txt>\n"
+              << "       " << program << " [--workers N] [--render] [--trace F] --replay <file.bmr>\n"
+              << "  --level N     Level to run, 1-based (default 1)\n"
+              << "  --all         Run every level in the pack\n"
+              << "  --steps N     Physics steps per level (default 7200)\n"
+              << "  --script F    Rotation input script (lines of '<steps> <L|N|R>')\n"
+              << "  --workers N   Box2D solver threads incl. the main one (default: all cores, 1 = single-threaded)\n"
+              << "  --fixed-step  Step physics at the fixed rate instead of adaptively\n"
+              << "  --render      Draw each step offscreen and report render times\n"
+              << "  --trace F     With --replay: save the last 600 frames as a Chrome trace\n"
+              << "  --verbose     Keep gameplay logging\n";
+}
+
+int main(int argc, char* argv[]) {
+    HeadlessConfig config;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool has_value = i + 1 < argc;
+        if (arg == "--level" && has_value) {
+            config.level_index = std::atoi(argv[++i]) - 1;
+        } else if (arg == "--all") {
+            config.all_levels = true;
+        } else if (arg == "--steps" && has_value) {
+            config.max_steps = std::atoi(argv[++i]);
+        } else if (arg == "--script" && has_value) {
+            config.script_path = argv[++i];
+        } else if (arg == "--workers" && has_value) {
+            config.worker_count = std::atoi(argv[++i]);
+        } else if (arg == "--replay" && has_value) {
+            config.replay_path = argv[++i];
+        } else if (arg == "--trace" && has_value) {
+            config.trace_path = argv[++i];
+        } else if (arg == "--fixed-step") {
+            config.adaptive_physics = false;
+        } else if (arg == "--render") {
+            config.render = true;
+        } else if (arg == "--verbose") {
+            config.verbose = true;
+        } else if (!arg.empty() && arg[0] != '-' && config.level_pack_path.empty()) {
+            config.level_pack_path = arg;
+        } else {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    if ((config.level_pack_path.empty() && config.replay_path.empty()) || config.max_steps <= 0) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    HeadlessRunner runner(config);
+    return runner.run();
+}
@@ -1,14 +1,63 @@
 #include "Game.h"
+#include <cstdlib>
 #include <iostream>
+#include <string>
 
 int main(int argc, char* argv[]) {
     Game game;
+    std::string replay_path;
+    bool fast_forward = false;
+    bool endless = false;
+    bool vsync = false;
+    int fps_cap = -1; // Not given
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--workers" && i + 1 < argc) {
+            game.setWorkerCount(std::atoi(argv[++i])); // 1 = single-threaded physics
+        } else if (arg == "--record" && i + 1 < argc) {
+            game.setRecordDirectory(argv[++i]);
+        } else if (arg == "--replay" && i + 1 < argc) {
+            replay_path = argv[++i];
+        } else if (arg == "--fast") {
+            fast_forward = true;
+        } else if (arg == "--endless") {
+            endless = true;
+        } else if (arg == "--seed" && i + 1 < argc) {
+            game.setEndlessSeed(std::strtoull(argv[++i], nullptr, 10));
+        } else if (arg == "--fps" && i + 1 < argc) {
+            fps_cap = std::atoi(argv[++i]); // 0 = uncapped
+        } else if (arg == "--vsync") {
+            vsync = true;
+        } else if (arg == "--fixed-step") {
+            game.setAdaptivePhysics(false); // Every step TIME_STEP long with POSITION_ITERATIONS sub-steps
+        } else {
+            std::cerr << "Usage: " << argv[0] << " [--workers N] [--fps N] [--vsync] [--fixed-step] [--record DIR] [--replay FILE [--fast]] [--endless [--seed N]]" << std::endl;
+            return -1;
+        }
+    }
+
+    // With vsync the display sets the rate unless a cap is asked for explicitly
+    if (fps_cap >= 0 || vsync) {
+        game.setFrameRateCap(fps_cap >= 0 ? fps_cap : 0);
+    }
+    game.setVSync(vsync);
+
     if (!game.init()) {
         std::cerr << "Failed to initialize game." << std::endl;
         return -1;
     }
 
-    // Start the game with the level selection screen
+    if (!replay_path.empty()) {
+        return game.runReplay(replay_path, fast_forward) ? 0 : 1;
+    }
+
+    if (endless && !game.startEndless()) {
+        std::cerr << "Failed to start endless mode." << std::endl;
+        return -1;
+    }
+
+    // Start the game with the level selection screen (or the first endless level)
     game.run();
 
     return 0;
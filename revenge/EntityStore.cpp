@@ -0,0 +1,252 @@
+#include "EntityStore.h"
+
+EntityStore::EntityStore() : m_allTilesChanged(true), m_gridWidth(0), m_gridHeight(0) {}
+
+void EntityStore::clear() {
+    for (int type = 0; type < ENTITY_TYPE_COUNT; ++type) {
+        m_arrays[type] = EntityArrays();
+        m_versions[type]++;
+    }
+    // Keep the slots so stale handles from the previous level can't match a new entity
+    m_freeSlots.clear();
+    for (uint32_t slot = 0; slot < m_slots.size(); ++slot) {
+        if (m_slots[slot].alive) {
+            m_slots[slot].alive = false;
+            m_slots[slot].generation++;
+        }
+        m_freeSlots.push_back(slot);
+    }
+    for (auto& tile : m_tiles) {
+        tile = Tile();
+    }
+    clearChangedTiles();
+    m_allTilesChanged = true;
+}
+
+void EntityStore::setGridSize(int width, int height) {
+    m_gridWidth = width;
+    m_gridHeight = height;
+    m_tiles.assign(static_cast<size_t>(width) * height, Tile());
+    m_tileChanged.assign(m_tiles.size(), 0);
+    m_changedTiles.clear();
+    m_allTilesChanged = true;
+    for (int type = 0; type < ENTITY_TYPE_COUNT; ++type) {
+        const EntityArrays& arrays = m_arrays[type];
+        for (size_t i = 0; i < arrays.size(); ++i) {
+            occupy(arrays.handle[i], static_cast<EntityType>(type), arrays.x[i], arrays.y[i]);
+        }
+    }
+}
+
+EntityHandle EntityStore::create(EntityType type, int x, int y) {
+    uint32_t slot;
+    if (!m_freeSlots.empty()) {
+        slot = m_freeSlots.back();
+        m_freeSlots.pop_back();
+    } else {
+        slot = static_cast<uint32_t>(m_slots.size());
+        m_slots.emplace_back();
+    }
+
+    EntityArrays& arrays = m_arrays[static_cast<int>(type)];
+    EntityHandle handle;
+    handle.slot = slot;
+    handle.generation = m_slots[slot].generation;
+
+    m_slots[slot].index = static_cast<uint32_t>(arrays.size());
+    m_slots[slot].type = type;
+    m_slots[slot].alive = true;
+
+    arrays.x.push_back(x);
+    arrays.y.push_back(y);
+    arrays.initialX.push_back(x);
+    arrays.initialY.push_back(y);
+    arrays.moveTimer.push_back(0);
+    arrays.handle.push_back(handle);
+    m_versions[static_cast<int>(type)]++;
+
+    occupy(handle, type, x, y);
+    markChanged(x, y);
+    return handle;
+}
+
+void EntityStore::destroy(EntityHandle handle) {
+    const Slot* found = lookup(handle);
+    if (!found) {
+        return;
+    }
+    Slot& slot = m_slots[handle.slot];
+    EntityArrays& arrays = m_arrays[static_cast<int>(slot.type)];
+    uint32_t index = slot.index;
+    vacate(handle, arrays.x[index], arrays.y[index]);
+    markChanged(arrays.x[index], arrays.y[index]);
+
+    // Swap-and-pop: the last entity of this type fills the hole
+    uint32_t last = static_cast<uint32_t>(arrays.size() - 1);
+    if (index != last) {
+        arrays.x[index] = arrays.x[last];
+        arrays.y[index] = arrays.y[last];
+        arrays.initialX[index] = arrays.initialX[last];
+        arrays.initialY[index] = arrays.initialY[last];
+        arrays.moveTimer[index] = arrays.moveTimer[last];
+        arrays.handle[index] = arrays.handle[last];
+        m_slots[arrays.handle[index].slot].index = index;
+    }
+    arrays.x.pop_back();
+    arrays.y.pop_back();
+    arrays.initialX.pop_back();
+    arrays.initialY.pop_back();
+    arrays.moveTimer.pop_back();
+    arrays.handle.pop_back();
+
+    m_versions[static_cast<int>(slot.type)]++;
+    slot.alive = false;
+    slot.generation++;
+    m_freeSlots.push_back(handle.slot);
+}
+
+void EntityStore::destroyAt(int x, int y) {
+    int index = tileIndex(x, y);
+    if (index < 0) {
+        return;
+    }
+    while (m_tiles[index].count > 0) {
+        EntityHandle handle = m_tiles[index].handle;
+        if (m_tiles[index].type == EntityType::PLAYER) {
+            handle = findOtherAt(x, y, handle);
+            if (!handle.isValid() || getType(handle) == EntityType::PLAYER) {
+                return; // Only players left
+            }
+        }
+        destroy(handle);
+    }
+}
+
+bool EntityStore::isAlive(EntityHandle handle) const {
+    return lookup(handle) != nullptr;
+}
+
+EntityType EntityStore::getType(EntityHandle handle) const {
+    return m_slots[handle.slot].type;
+}
+
+int EntityStore::getX(EntityHandle handle) const {
+    const Slot& slot = m_slots[handle.slot];
+    return m_arrays[static_cast<int>(slot.type)].x[slot.index];
+}
+
+int EntityStore::getY(EntityHandle handle) const {
+    const Slot& slot = m_slots[handle.slot];
+    return m_arrays[static_cast<int>(slot.type)].y[slot.index];
+}
+
+void EntityStore::setPosition(EntityHandle handle, int x, int y) {
+    const Slot* slot = lookup(handle);
+    if (!slot) {
+        return;
+    }
+    EntityArrays& arrays = m_arrays[static_cast<int>(slot->type)];
+    vacate(handle, arrays.x[slot->index], arrays.y[slot->index]);
+    markChanged(arrays.x[slot->index], arrays.y[slot->index]);
+    arrays.x[slot->index] = x;
+    arrays.y[slot->index] = y;
+    m_versions[static_cast<int>(slot->type)]++;
+    occupy(handle, slot->type, x, y);
+    markChanged(x, y);
+}
+
+void EntityStore::resetPositions() {
+    // Move everything first and index once, instead of tracking every intermediate overlap
+    for (int type = 0; type < ENTITY_TYPE_COUNT; ++type) {
+        m_arrays[type].x = m_arrays[type].initialX;
+        m_arrays[type].y = m_arrays[type].initialY;
+        m_versions[type]++;
+    }
+    setGridSize(m_gridWidth, m_gridHeight);
+}
+
+EntityHandle EntityStore::getAt(int x, int y) const {
+    int index = tileIndex(x, y);
+    return index < 0 ? EntityHandle() : m_tiles[index].handle;
+}
+
+bool EntityStore::isOccupied(int x, int y) const {
+    int index = tileIndex(x, y);
+    return index >= 0 && m_tiles[index].count > 0;
+}
+
+bool EntityStore::isTypeAt(int x, int y, EntityType type) const {
+    int index = tileIndex(x, y);
+    return index >= 0 && m_tiles[index].count > 0 && m_tiles[index].type == type;
+}
+
+void EntityStore::clearChangedTiles() {
+    for (int index : m_changedTiles) {
+        m_tileChanged[index] = 0;
+    }
+    m_changedTiles.clear();
+    m_allTilesChanged = false;
+}
+
+const EntityStore::Slot* EntityStore::lookup(EntityHandle handle) const {
+    if (handle.slot >= m_slots.size()) {
+        return nullptr;
+    }
+    const Slot& slot = m_slots[handle.slot];
+    return slot.alive && slot.generation == handle.generation ? &slot : nullptr;
+}
+
+int EntityStore::tileIndex(int x, int y) const {
+    if (x < 0 || y < 0 || x >= m_gridWidth || y >= m_gridHeight) {
+        return -1;
+    }
+    return y * m_gridWidth + x;
+}
+
+void EntityStore::markChanged(int x, int y) {
+    int index = tileIndex(x, y);
+    if (index < 0 || m_tileChanged[index]) {
+        return;
+    }
+    m_tileChanged[index] = 1;
+    m_changedTiles.push_back(index);
+}
+
+void EntityStore::occupy(EntityHandle handle, EntityType type, int x, int y) {
+    int index = tileIndex(x, y);
+    if (index < 0) {
+        return;
+    }
+    Tile& tile = m_tiles[index];
+    if (tile.count++ == 0) {
+        tile.handle = handle;
+        tile.type = type;
+    }
+}
+
+void EntityStore::vacate(EntityHandle handle, int x, int y) {
+    int index = tileIndex(x, y);
+    if (index < 0 || m_tiles[index].count == 0) {
+        return;
+    }
+    Tile& tile = m_tiles[index];
+    if (--tile.count == 0) {
+        tile = Tile();
+    } else if (tile.handle == handle) {
+        tile.handle = findOtherAt(x, y, handle); // Whoever else is still there
+        if (tile.handle.isValid()) {
+            tile.type = getType(tile.handle);
+        }
+    }
+}
+
+EntityHandle EntityStore::findOtherAt(int x, int y, EntityHandle except) const {
+    for (const auto& arrays : m_arrays) {
+        for (size_t i = 0; i < arrays.size(); ++i) {
+            if (arrays.x[i] == x && arrays.y[i] == y && arrays.handle[i] != except) {
+                return arrays.handle[i];
+            }
+        }
+    }
+    return EntityHandle();
+}
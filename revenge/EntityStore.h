@@ -0,0 +1,124 @@
+#ifndef ENTITYSTORE_H
+#define ENTITYSTORE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// What kind of entity this is. Each type has its own dense arrays in the EntityStore.
+enum class EntityType : uint8_t {
+    PLAYER,
+    BLOCK,
+    CAT,
+    CHEESE,
+    TRAP,
+    HOLE
+};
+
+const int ENTITY_TYPE_COUNT = 6;
+
+// Stable reference to an entity. Stays valid however the dense arrays get reordered;
+// once the entity is destroyed its slot's generation moves on and the handle goes stale.
+struct EntityHandle {
+    static constexpr uint32_t INVALID_SLOT = UINT32_MAX;
+
+    uint32_t slot = INVALID_SLOT;
+    uint32_t generation = 0;
+
+    bool isValid() const { return slot != INVALID_SLOT; }
+    bool operator==(const EntityHandle& other) const { return slot == other.slot && generation == other.generation; }
+    bool operator!=(const EntityHandle& other) const { return !(*this == other); }
+};
+
+// Dense arrays for one entity type: index i in every vector is the same entity.
+// Removal swaps the last entity into the hole, so the order changes but stays packed.
+struct EntityArrays {
+    std::vector<int> x, y;               // Grid coordinates
+    std::vector<int> initialX, initialY; // Where resetPositions() puts them back
+    std::vector<int> moveTimer;          // Frames since the last move (cats)
+    std::vector<EntityHandle> handle;
+
+    size_t size() const { return x.size(); }
+};
+
+// Struct-of-arrays storage for everything on a level's grid, plus an occupancy index
+// telling which entity stands on each tile in O(1). Positions must change through
+// setPosition() so the index stays in step.
+class EntityStore {
+public:
+    EntityStore();
+
+    // Removes every entity and invalidates all handles
+    void clear();
+    // Sizes the occupancy index (row-major, width per row) and fills it from the arrays
+    void setGridSize(int width, int height);
+
+    EntityHandle create(EntityType type, int x, int y);
+    void destroy(EntityHandle handle);
+    // Destroys whatever stands on the tile, except players, which only ever move
+    void destroyAt(int x, int y);
+    bool isAlive(EntityHandle handle) const;
+
+    EntityType getType(EntityHandle handle) const;
+    int getX(EntityHandle handle) const;
+    int getY(EntityHandle handle) const;
+    void setPosition(EntityHandle handle, int x, int y);
+    void resetPositions();
+
+    // The entity on a tile, or an invalid handle. When entities share a tile (the mouse
+    // in a hole) it is the one that got there first.
+    EntityHandle getAt(int x, int y) const;
+    bool isOccupied(int x, int y) const;
+    bool isTypeAt(int x, int y, EntityType type) const;
+
+    int getGridWidth() const { return m_gridWidth; }
+    int getGridHeight() const { return m_gridHeight; }
+    // Goes up whenever an entity of the type is created, destroyed or moved, so systems
+    // that derive data from the layout can tell when it is stale
+    uint32_t getVersion(EntityType type) const { return m_versions[static_cast<int>(type)]; }
+
+    // Tiles (row-major indices) that something moved onto or off, or was created or destroyed
+    // on, since the last clearChangedTiles(), each listed once. Loading and resetting
+    // move everything at once; they set allTilesChanged() instead of listing every tile.
+    const std::vector<int>& getChangedTiles() const { return m_changedTiles; }
+    bool allTilesChanged() const { return m_allTilesChanged; }
+    bool hasChangedTiles() const { return m_allTilesChanged || !m_changedTiles.empty(); }
+    void clearChangedTiles();
+
+    const EntityArrays& ofType(EntityType type) const { return m_arrays[static_cast<int>(type)]; }
+    std::vector<int>& getMoveTimers(EntityType type) { return m_arrays[static_cast<int>(type)].moveTimer; }
+    int count(EntityType type) const { return static_cast<int>(ofType(type).size()); }
+
+private:
+    struct Slot {
+        uint32_t generation = 0;
+        uint32_t index = 0; // Into the type's dense arrays
+        EntityType type = EntityType::PLAYER;
+        bool alive = false;
+    };
+
+    struct Tile {
+        EntityHandle handle;
+        EntityType type = EntityType::PLAYER;
+        uint16_t count = 0;
+    };
+
+    const Slot* lookup(EntityHandle handle) const;
+    int tileIndex(int x, int y) const; // -1 outside the grid
+    void markChanged(int x, int y);
+    void occupy(EntityHandle handle, EntityType type, int x, int y);
+    void vacate(EntityHandle handle, int x, int y);
+    EntityHandle findOtherAt(int x, int y, EntityHandle except) const; // Scan, shared tiles only
+
+    EntityArrays m_arrays[ENTITY_TYPE_COUNT];
+    uint32_t m_versions[ENTITY_TYPE_COUNT] = {};
+    std::vector<Slot> m_slots;
+    std::vector<uint32_t> m_freeSlots;
+    std::vector<Tile> m_tiles;
+    std::vector<int> m_changedTiles;
+    std::vector<uint8_t> m_tileChanged; // Per tile, so m_changedTiles lists each one once
+    bool m_allTilesChanged;
+    int m_gridWidth, m_gridHeight;
+};
+
+#endif // ENTITYSTORE_H
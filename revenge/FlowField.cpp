@@ -0,0 +1,110 @@
+#include "FlowField.h"
+#include "Level.h"
+#include <cstdlib> // For rand()
+
+namespace {
+
+const int DIRECTIONS[8][2] = {
+    {0, -1}, {0, 1}, {-1, 0}, {1, 0},  // Cardinal
+    {1, -1}, {1, 1}, {-1, 1}, {-1, -1} // Diagonal
+};
+
+uint64_t layoutVersion(const EntityStore& entities) {
+    uint64_t version = 0;
+    for (int type = 0; type < ENTITY_TYPE_COUNT; ++type) {
+        if (static_cast<EntityType>(type) != EntityType::CAT) {
+            version += entities.getVersion(static_cast<EntityType>(type));
+        }
+    }
+    return version;
+}
+
+} // namespace
+
+FlowField::FlowField() : m_width(0), m_height(0), m_builtVersion(0), m_built(false), m_rebuildCount(0) {}
+
+void FlowField::update(const Level& level) {
+    // Versions only ever go up, so their sum changes whenever any of them does
+    uint64_t version = layoutVersion(level.getEntities());
+    if (m_built && version == m_builtVersion) {
+        return;
+    }
+    rebuild(level);
+    m_builtVersion = version;
+    m_built = true;
+}
+
+int FlowField::getDistance(int x, int y) const {
+    if (x < 0 || y < 0 || x >= m_width || y >= m_height) {
+        return UNREACHABLE;
+    }
+    return m_distance[y * m_width + x];
+}
+
+bool FlowField::nextStep(const Level& level, int x, int y, int& dx, int& dy) const {
+    const EntityStore& entities = level.getEntities();
+    int bestDistance = getDistance(x, y);
+    bool found = false;
+    // Start at a random direction so cats don't all prefer the same one on ties
+    int first = rand() % 8;
+    for (int i = 0; i < 8; ++i) {
+        const int* dir = DIRECTIONS[(first + i) % 8];
+        int checkX = x + dir[0];
+        int checkY = y + dir[1];
+        int distance = getDistance(checkX, checkY);
+        if (distance < bestDistance && !entities.isOccupied(checkX, checkY)) {
+            bestDistance = distance;
+            dx = dir[0];
+            dy = dir[1];
+            found = true;
+        }
+    }
+    return found;
+}
+
+void FlowField::rebuild(const Level& level) {
+    const EntityStore& entities = level.getEntities();
+    m_width = entities.getGridWidth();
+    m_height = entities.getGridHeight();
+    m_distance.assign(static_cast<size_t>(m_width) * m_height, UNREACHABLE);
+    m_rebuildCount++;
+
+    Player* player = level.getPlayer();
+    if (!player || player->getX() < 0 || player->getY() < 0 || player->getX() >= m_width || player->getY() >= m_height) {
+        return; // No mouse, or it is off the grid
+    }
+
+    // Walls, blocks, cheese, traps and holes are in the way; the search then only reads this
+    m_walkable.resize(m_distance.size());
+    for (int y = 0; y < m_height; ++y) {
+        for (int x = 0; x < m_width; ++x) {
+            bool blocked = level.isTileSolid(x, y) || (entities.isOccupied(x, y) && !entities.isTypeAt(x, y, EntityType::CAT));
+            m_walkable[y * m_width + x] = blocked ? 0 : 1;
+        }
+    }
+
+    // Breadth-first search out from the mouse over the tiles a cat could walk on
+    int start = player->getY() * m_width + player->getX();
+    m_queue.clear();
+    m_distance[start] = 0;
+    m_queue.push_back(start);
+    for (size_t head = 0; head < m_queue.size(); ++head) {
+        int index = m_queue[head];
+        int x = index % m_width;
+        int y = index / m_width;
+        int nextDistance = m_distance[index] + 1;
+        for (const auto& dir : DIRECTIONS) {
+            int nextX = x + dir[0];
+            int nextY = y + dir[1];
+            if (nextX < 0 || nextY < 0 || nextX >= m_width || nextY >= m_height) {
+                continue;
+            }
+            int nextIndex = nextY * m_width + nextX;
+            if (!m_walkable[nextIndex] || m_distance[nextIndex] != UNREACHABLE) {
+                continue;
+            }
+            m_distance[nextIndex] = nextDistance;
+            m_queue.push_back(nextIndex);
+        }
+    }
+}
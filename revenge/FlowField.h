@@ -0,0 +1,40 @@
+#ifndef FLOWFIELD_H
+#define FLOWFIELD_H
+
+#include <cstdint>
+#include <vector>
+
+class Level;
+
+// Distance in cat steps (8-way, like the cats move) from every tile to the mouse, shared by
+// all cats so each one picks its next step by looking at its 8 neighbours. Other cats don't
+// count as obstacles here, otherwise every cat move would invalidate the field; the step
+// itself still has to land on a free tile.
+class FlowField {
+public:
+    static constexpr int UNREACHABLE = INT32_MAX;
+
+    FlowField();
+
+    // Rebuilds the field if the mouse, a block, cheese, trap or hole changed since the last
+    // call (or the level was reloaded). Otherwise returns right away.
+    void update(const Level& level);
+
+    int getDistance(int x, int y) const;
+    // The free neighbour of (x, y) closest to the mouse, if it is closer than (x, y) itself
+    bool nextStep(const Level& level, int x, int y, int& dx, int& dy) const;
+    int getRebuildCount() const { return m_rebuildCount; }
+
+private:
+    void rebuild(const Level& level);
+
+    std::vector<int> m_distance; // Row-major, m_width per row
+    std::vector<uint8_t> m_walkable; // Rebuilt with the field
+    std::vector<int> m_queue;        // BFS frontier, kept to avoid reallocating
+    int m_width, m_height;
+    uint64_t m_builtVersion; // Sum of the entity store's non-cat versions at the last rebuild
+    bool m_built;
+    int m_rebuildCount;
+};
+
+#endif // FLOWFIELD_H
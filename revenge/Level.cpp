@@ -1,18 +1,22 @@
 #include "Level.h"
 #include "Player.h" // Include Player definition for implementation
 #include "TextureManager.h"
-#include "Block.h"
-#include "Cat.h"
-#include "Cheese.h"
-#include "Trap.h"
-#include "Hole.h"
 #include <fstream>
 #include <iostream>
 #include <algorithm>
+#include <cstdlib> // For rand()
+#include <ctime>   // For time()
+
+Level::Level() : m_width(0), m_height(0), m_tileSize(32), m_catCount(0), m_cheeseCount(0) {
+    // Seed the random number generator for the cats once
+    static bool seeded = false;
+    if (!seeded) {
+        srand(time(0));
+        seeded = true;
+    }
+}
 
-Level::Level() : m_width(0), m_height(0), m_tileSize(32), m_player(nullptr), m_catCount(0), m_cheeseCount(0) {}
-
-Level::~Level() {} // GameObjects are now managed by unique_ptrs in a vector, so cleanup is automatic.
+Level::~Level() {} // Entities live in m_entities' arrays, so cleanup is automatic.
 
 bool Level::load(const std::string& filename, int startLineHint) {
     std::ifstream file(filename);
@@ -22,8 +26,8 @@ bool Level::load(const std::string& filename, int startLineHint) {
     }
 
     m_levelData.clear();
-    m_gameObjects.clear();
-    m_player = nullptr;
+    m_entities.clear();
+    m_player.reset();
     m_catCount = 0;
     m_cheeseCount = 0;
 
@@ -66,27 +70,25 @@ bool Level::load(const std::string& filename, int startLineHint) {
             char tile = line[x_coord];
 
             if (tile == 'M') {
-                auto player = std::make_unique<Player>(x_coord, y_coord, m_tileSize, m_tileSize);
-                m_player = player.get(); // Get raw pointer
-                m_gameObjects.push_back(std::move(player));
-                row.push_back('.'); // The player object now represents the mouse
+                m_player = std::make_unique<Player>(m_entities, m_entities.create(EntityType::PLAYER, x_coord, y_coord), m_tileSize);
+                row.push_back('.'); // The player entity now represents the mouse
             } else if (tile == 'B') {
-                m_gameObjects.push_back(std::make_unique<Block>(x_coord, y_coord, m_tileSize, m_tileSize));
-                row.push_back('.'); // The block object now represents the block
+                m_entities.create(EntityType::BLOCK, x_coord, y_coord);
+                row.push_back('.'); // The block entity now represents the block
             } else if (tile == 'C') { // 'C' is Cheese
-                m_gameObjects.push_back(std::make_unique<Cheese>(x_coord, y_coord, m_tileSize, m_tileSize));
+                m_entities.create(EntityType::CHEESE, x_coord, y_coord);
                 m_cheeseCount++;
-                row.push_back('.'); // The cheese object now represents the cheese
+                row.push_back('.'); // The cheese entity now represents the cheese
             } else if (tile == 'K') { // 'K' is now for Cat
-                m_gameObjects.push_back(std::make_unique<Cat>(x_coord, y_coord, m_tileSize, m_tileSize));
+                m_entities.create(EntityType::CAT, x_coord, y_coord);
                 m_catCount++;
-                row.push_back('.'); // The cat object now represents the cat
+                row.push_back('.'); // The cat entity now represents the cat
             } else if (tile == 'T') { // 'T' is for Trap
-                m_gameObjects.push_back(std::make_unique<Trap>(x_coord, y_coord, m_tileSize));
-                row.push_back('.'); // The trap object now represents the trap
+                m_entities.create(EntityType::TRAP, x_coord, y_coord);
+                row.push_back('.'); // The trap entity now represents the trap
             } else if (tile == 'H') { // 'H' is for Hole
-                m_gameObjects.push_back(std::make_unique<Hole>(x_coord, y_coord, m_tileSize));
-                row.push_back('.'); // The hole object now represents the hole
+                m_entities.create(EntityType::HOLE, x_coord, y_coord);
+                row.push_back('.'); // The hole entity now represents the hole
             } else {
                 row.push_back(tile);
             }
@@ -102,6 +104,12 @@ bool Level::load(const std::string& filename, int startLineHint) {
         m_height = 0;
         m_width = 0;
     }
+    // Rows can be longer than the first one, which sets m_width
+    int gridWidth = m_width;
+    for (const auto& row : m_levelData) {
+        gridWidth = std::max(gridWidth, static_cast<int>(row.size()));
+    }
+    m_entities.setGridSize(gridWidth, m_height);
     
     file.close();
     return true;
@@ -128,16 +136,22 @@ void Level::render(SDL_Renderer* renderer, int offsetX, int offsetY) {
             }
         }
     }
-    // Render all game objects
-    for (const auto& obj : m_gameObjects) {
-        obj->render(renderer, offsetX, offsetY);
+    // Render the entities type by type, floor items first; the mouse goes on top
+    static const EntityType drawOrder[] = {EntityType::HOLE, EntityType::TRAP, EntityType::CHEESE, EntityType::BLOCK, EntityType::CAT};
+    static const char* const textureIds[] = {"hole", "mousetrap", "cheese", "block", "cat"};
+    for (int i = 0; i < 5; ++i) {
+        const EntityArrays& arrays = m_entities.ofType(drawOrder[i]);
+        for (size_t j = 0; j < arrays.size(); ++j) {
+            TextureManager::draw(textureIds[i], arrays.x[j] * m_tileSize, arrays.y[j] * m_tileSize, m_tileSize, m_tileSize, renderer, offsetX, offsetY);
+        }
+    }
+    if (m_player) {
+        m_player->render(renderer, offsetX, offsetY);
     }
 }
 
 void Level::resetAllPositions() {
-    for (auto& obj : m_gameObjects) {
-        obj->resetPosition();
-    }
+    m_entities.resetPositions();
 }
 
 bool Level::isTileSolid(int gridX, int gridY) const {
@@ -152,16 +166,7 @@ bool Level::isTileSolid(int gridX, int gridY) const {
 }
 
 Player* Level::getPlayer() const {
-    return m_player;
-}
-
-GameObject* Level::getGameObjectAt(int x, int y) const {
-    for (const auto& obj : m_gameObjects) {
-        if (obj->getX() == x && obj->getY() == y) {
-            return obj.get();
-        }
-    }
-    return nullptr;
+    return m_player.get();
 }
 
 int Level::getWidth() const {
@@ -172,17 +177,8 @@ int Level::getHeight() const {
     return m_height;
 }
 
-const std::vector<std::unique_ptr<GameObject>>& Level::getGameObjects() const {
-    return m_gameObjects;
-}
-
-void Level::removeGameObjectAt(int x, int y) {
-    m_gameObjects.erase(
-        std::remove_if(m_gameObjects.begin(), m_gameObjects.end(),
-                       [&](const std::unique_ptr<GameObject>& obj) {
-                           return obj->getX() == x && obj->getY() == y;
-                       }),
-        m_gameObjects.end());
+void Level::removeEntitiesAt(int x, int y) {
+    m_entities.destroyAt(x, y);
 }
 
 int Level::getCatCount() const {
@@ -207,55 +203,128 @@ int Level::getTileSize() const {
     return m_tileSize;
 }
 
-void Level::updateTrappedCats() {
-    const int POINTS_PER_CAT_TRAP = 100;
-    std::vector<GameObject*> catsToReplace;
-
-    // Find all cats that are trapped
-    for (auto& obj : m_gameObjects) {
-        Cat* cat = dynamic_cast<Cat*>(obj.get());
-        if (!cat) continue;
-
-        int x = cat->getX();
-        int y = cat->getY();
-
-        // Check all 8 surrounding tiles (including diagonals)
-        bool isTrapped = true;
-        int directions[8][2] = {
-            {0, -1}, {0, 1}, {-1, 0}, {1, 0}, // Cardinal
-            {-1, -1}, {-1, 1}, {1, -1}, {1, 1}  // Diagonal
-        };
-
-        for (auto& dir : directions) {
-            int checkX = x + dir[0];
-            int checkY = y + dir[1];
-
-            GameObject* blockingObject = getGameObjectAt(checkX, checkY);
-            // A space is considered blocked if it's a solid wall tile OR if it's occupied by a block.
-            bool isSpaceBlocked = isTileSolid(checkX, checkY) || (blockingObject && dynamic_cast<Block*>(blockingObject));
-
-            if (!isSpaceBlocked) {
-                isTrapped = false;
-                break;
+void Level::updateCats() {
+    const EntityArrays& cats = m_entities.ofType(EntityType::CAT);
+    std::vector<int>& moveTimers = m_entities.getMoveTimers(EntityType::CAT);
+    bool fieldUpdated = false;
+
+    for (size_t i = 0; i < cats.size(); ++i) {
+        if (++moveTimers[i] < CAT_MOVE_DELAY) {
+            continue; // Not time to move yet
+        }
+        moveTimers[i] = 0; // Reset timer
+
+        // Cats moving don't invalidate the field, so once per frame is enough
+        if (!fieldUpdated) {
+            m_catField.update(*this);
+            fieldUpdated = true;
+        }
+
+        int x = cats.x[i];
+        int y = cats.y[i];
+        int dx = 0, dy = 0;
+
+        if (m_catField.getDistance(x, y) != FlowField::UNREACHABLE) {
+            // Chase the mouse; stay put when every closer tile is taken
+            if (!m_catField.nextStep(*this, x, y, dx, dy)) {
+                continue;
+            }
+        } else {
+            // Walled off from the mouse: wander in a random direction as before
+            int moveDirection = rand() % 8; // 0-3 for cardinal, 4-7 for diagonal
+            switch (moveDirection) {
+                // Cardinal directions
+                case 0: dy = -1; break; // Up
+                case 1: dy = 1;  break; // Down
+                case 2: dx = -1;  break; // Left
+                case 3: dx = 1;   break; // Right
+                // Diagonal directions
+                case 4: dx = 1;  dy = -1; break; // Up-Right
+                case 5: dx = 1;  dy = 1;  break; // Down-Right
+                case 6: dx = -1; dy = 1;  break; // Down-Left
+                case 7: dx = -1; dy = -1; break; // Up-Left
             }
         }
 
-        if (isTrapped) {
-            catsToReplace.push_back(cat);
+        int newX = x + dx;
+        int newY = y + dy;
+
+        // Check if the target destination is valid (not solid and not occupied).
+        // This version allows moving through diagonal gaps where corners meet.
+        if (!isTileSolid(newX, newY) && !m_entities.isOccupied(newX, newY)) {
+            m_entities.setPosition(cats.handle[i], newX, newY);
+        }
+    }
+}
+
+bool Level::isCatTrapped(int x, int y) const {
+    // Check all 8 surrounding tiles (including diagonals)
+    static const int directions[8][2] = {
+        {0, -1}, {0, 1}, {-1, 0}, {1, 0}, // Cardinal
+        {-1, -1}, {-1, 1}, {1, -1}, {1, 1}  // Diagonal
+    };
+
+    for (auto& dir : directions) {
+        int checkX = x + dir[0];
+        int checkY = y + dir[1];
+
+        // A space is considered blocked if it's a solid wall tile OR if it's occupied by a block.
+        bool isSpaceBlocked = isTileSolid(checkX, checkY) || m_entities.isTypeAt(checkX, checkY, EntityType::BLOCK);
+
+        if (!isSpaceBlocked) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void Level::updateTrappedCats() {
+    const int POINTS_PER_CAT_TRAP = 100;
+
+    // A cat's status only changes when something moves on or next to its tile
+    if (!m_entities.hasChangedTiles()) {
+        return;
+    }
+
+    const EntityArrays& cats = m_entities.ofType(EntityType::CAT);
+    m_catsToCheck.clear();
+    if (m_entities.allTilesChanged()) {
+        m_catsToCheck = cats.handle;
+    } else {
+        int gridWidth = m_entities.getGridWidth();
+        for (int index : m_entities.getChangedTiles()) {
+            int x = index % gridWidth;
+            int y = index / gridWidth;
+            for (int checkY = y - 1; checkY <= y + 1; ++checkY) {
+                for (int checkX = x - 1; checkX <= x + 1; ++checkX) {
+                    if (!m_entities.isTypeAt(checkX, checkY, EntityType::CAT)) {
+                        continue;
+                    }
+                    EntityHandle cat = m_entities.getAt(checkX, checkY);
+                    if (std::find(m_catsToCheck.begin(), m_catsToCheck.end(), cat) == m_catsToCheck.end()) {
+                        m_catsToCheck.push_back(cat);
+                    }
+                }
+            }
         }
     }
+    // The cheese added below marks its tile again, which is harmless: cheese traps nothing
+    m_entities.clearChangedTiles();
 
     // Replace trapped cats with cheese
-    for (auto* cat : catsToReplace) {
-        int x = cat->getX();
-        int y = cat->getY();
+    for (EntityHandle cat : m_catsToCheck) {
+        int x = m_entities.getX(cat);
+        int y = m_entities.getY(cat);
+        if (!isCatTrapped(x, y)) {
+            continue;
+        }
 
         // Remove the cat
-        removeGameObjectAt(x, y);
+        m_entities.destroy(cat);
         decrementCatCount();
 
         // Add cheese in its place
-        m_gameObjects.push_back(std::make_unique<Cheese>(x, y, m_tileSize, m_tileSize));
+        m_entities.create(EntityType::CHEESE, x, y);
         m_cheeseCount++;
 
         // Award points to the player
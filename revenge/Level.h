@@ -5,9 +5,9 @@
 #include <vector>
 #include <SDL2/SDL.h>
 #include <memory> // For std::unique_ptr
-#include <vector>
-#include "GameObject.h"
-class Player; // Forward-declare Player to break circular dependency
+#include "EntityStore.h"
+#include "FlowField.h"
+#include "Player.h"
 
 class Level {
 public:
@@ -23,11 +23,18 @@ public:
     int getTileSize() const;
 
     bool isTileSolid(int x, int y) const;
-    GameObject* getGameObjectAt(int x, int y) const;
+    // Blocks, cats, cheese, traps, holes and the mouse, with their O(1) tile lookup
+    EntityStore& getEntities() { return m_entities; }
+    const EntityStore& getEntities() const { return m_entities; }
+    // Distances to the mouse the cats chase along
+    const FlowField& getCatField() const { return m_catField; }
     Player* getPlayer() const;
-    const std::vector<std::unique_ptr<GameObject>>& getGameObjects() const;
 
-    void removeGameObjectAt(int x, int y);
+    // Removes everything on the tile except the mouse
+    void removeEntitiesAt(int x, int y);
+    void updateCats();
+    // Turns cats with walls or blocks on all 8 sides into cheese. Only cats on or next to
+    // tiles that changed since the last call are checked, so a still frame costs nothing.
     void updateTrappedCats();
     int getCatCount() const;
     int getCheeseCount() const;
@@ -35,10 +42,16 @@ public:
     void decrementCheeseCount();
 
 private:
+    static const int CAT_MOVE_DELAY = 30; // Higher value = slower cats. Moves roughly every half-second.
+
+    bool isCatTrapped(int x, int y) const;
+
     int m_width, m_height, m_tileSize;
     std::vector<std::vector<char>> m_levelData;
-    std::vector<std::unique_ptr<GameObject>> m_gameObjects;
-    Player* m_player;
+    EntityStore m_entities;
+    FlowField m_catField;
+    std::vector<EntityHandle> m_catsToCheck; // Kept to avoid reallocating every frame
+    std::unique_ptr<Player> m_player;
     int m_catCount;
     int m_cheeseCount;
 };
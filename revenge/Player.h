@@ -1,7 +1,7 @@
 #ifndef PLAYER_H
 #define PLAYER_H
 
-#include "GameObject.h"
+#include "EntityStore.h"
 #include <SDL2/SDL.h>
 
 class Level; // Forward declaration
@@ -15,13 +15,18 @@ enum class MoveResult {
     SUCCESS_HOLE
 };
 
-class Player : public GameObject {
+// The mouse. Its position lives in the level's EntityStore like every other entity;
+// this class keeps the handle plus what only the player has (lives, score, hole timer).
+class Player {
 public:
-    Player(int x, int y, int width, int height);
+    Player(EntityStore& entities, EntityHandle handle, int tileSize);
 
-    void render(SDL_Renderer* renderer, int offsetX = 0, int offsetY = 0) override;
+    void render(SDL_Renderer* renderer, int offsetX = 0, int offsetY = 0);
     MoveResult move(int dx, int dy, Level& level);
-    void update(Level& level) override; // Player-specific update logic if any
+
+    int getX() const { return m_entities.getX(m_handle); }
+    int getY() const { return m_entities.getY(m_handle); }
+    EntityHandle getHandle() const { return m_handle; }
 
     void setLives(int lives) { m_lives = lives; }
     void decrementLife() { m_lives--; } // Use this instead of loseLife
@@ -32,6 +37,11 @@ public:
     bool isStuck() const;
 
 private:
+    void setPosition(int x, int y) { m_entities.setPosition(m_handle, x, y); }
+
+    EntityStore& m_entities;
+    EntityHandle m_handle;
+    int m_tileSize;
     int m_lives;
     Uint32 m_stuckUntil = 0;
     int m_score; // Player's score
@@ -0,0 +1,284 @@
+// Microbenchmark for the level's entity storage: the trapped-cat check that runs every frame
+// and the remove-and-replace a trapped cat turns into, once on the EntityStore's dense
+// arrays and once on a copy of the old layout (heap-allocated objects in a vector of
+// unique_ptr, a pointer per tile, removal with remove_if). Then times the game's incremental
+// trapped-cat check on its own. Builds a large generated level.
+//
+// Usage: ./bench_entities [frames]
+
+#include "Level.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <random>
+
+// Global debug flag, normally defined in main.cpp
+bool g_debugMode = false;
+
+namespace {
+
+const int LEVEL_WIDTH = 96;
+const int LEVEL_HEIGHT = 64;
+const int CAT_COUNT = 60;
+const double BLOCK_DENSITY = 0.45;
+
+const int NEIGHBOURS[8][2] = {
+    {0, -1}, {0, 1}, {-1, 0}, {1, 0},
+    {-1, -1}, {-1, 1}, {1, -1}, {1, 1}
+};
+
+std::string writeBenchLevel() {
+    std::mt19937 rng(12345);
+    std::uniform_real_distribution<double> chance(0.0, 1.0);
+    std::vector<std::string> rows(LEVEL_HEIGHT, std::string(LEVEL_WIDTH, '.'));
+    for (int y = 0; y < LEVEL_HEIGHT; ++y) {
+        for (int x = 0; x < LEVEL_WIDTH; ++x) {
+            if (x == 0 || y == 0 || x == LEVEL_WIDTH - 1 || y == LEVEL_HEIGHT - 1) {
+                rows[y][x] = 'W';
+            } else if (chance(rng) < BLOCK_DENSITY) {
+                rows[y][x] = 'B';
+            }
+        }
+    }
+    std::uniform_int_distribution<int> column(1, LEVEL_WIDTH - 2);
+    std::uniform_int_distribution<int> row(1, LEVEL_HEIGHT - 2);
+    for (int placed = 0; placed < CAT_COUNT;) {
+        char& tile = rows[row(rng)][column(rng)];
+        if (tile == '.') {
+            tile = 'K';
+            placed++;
+        }
+    }
+    rows[LEVEL_HEIGHT / 2][LEVEL_WIDTH / 2] = 'M';
+
+    std::string path = (std::filesystem::temp_directory_path() / "bench_entities.lvl").string();
+    std::ofstream file(path);
+    file << "; Bench\n";
+    for (const auto& line : rows) {
+        file << line << "\n";
+    }
+    return path;
+}
+
+// The old layout: one virtual object per entity on the heap, a pointer per tile
+struct LegacyObject {
+    LegacyObject(int x, int y, EntityType type) : x(x), y(y), type(type) {}
+    virtual ~LegacyObject() {}
+    int x, y;
+    EntityType type;
+};
+
+struct LegacyLevel {
+    std::vector<std::unique_ptr<LegacyObject>> objects;
+    std::vector<LegacyObject*> tiles;
+    int width = 0;
+    int height = 0;
+
+    explicit LegacyLevel(const Level& level) : width(level.getWidth()), height(level.getHeight()) {
+        tiles.assign(static_cast<size_t>(width) * height, nullptr);
+        // Same order as the file, like the old loader
+        for (int y = 0; y < height; ++y) {
+            for (int x = 0; x < width; ++x) {
+                EntityHandle handle = level.getEntities().getAt(x, y);
+                if (handle.isValid()) {
+                    add(x, y, level.getEntities().getType(handle));
+                }
+            }
+        }
+    }
+
+    void add(int x, int y, EntityType type) {
+        objects.push_back(std::make_unique<LegacyObject>(x, y, type));
+        tiles[y * width + x] = objects.back().get();
+    }
+
+    LegacyObject* at(int x, int y) const {
+        return x < 0 || y < 0 || x >= width || y >= height ? nullptr : tiles[y * width + x];
+    }
+
+    void removeAt(int x, int y) {
+        tiles[y * width + x] = nullptr;
+        objects.erase(std::remove_if(objects.begin(), objects.end(),
+                                     [&](const std::unique_ptr<LegacyObject>& obj) { return obj->x == x && obj->y == y; }),
+                      objects.end());
+    }
+};
+
+// The frame's read-only work: find the cats, then look for blocks around each.
+// Returns the number of blocked neighbour tiles so the loops can't be optimized away.
+int legacyFrame(const Level& level, LegacyLevel& legacy) {
+    int blocked = 0;
+    for (const auto& obj : legacy.objects) {
+        if (obj->type != EntityType::CAT) continue;
+        for (const auto& dir : NEIGHBOURS) {
+            int checkX = obj->x + dir[0];
+            int checkY = obj->y + dir[1];
+            LegacyObject* blockingObject = legacy.at(checkX, checkY);
+            if (level.isTileSolid(checkX, checkY) || (blockingObject && blockingObject->type == EntityType::BLOCK)) {
+                blocked++;
+            }
+        }
+    }
+    return blocked;
+}
+
+int storeFrame(const Level& level, LegacyLevel&) {
+    int blocked = 0;
+    const EntityStore& entities = level.getEntities();
+    const EntityArrays& cats = entities.ofType(EntityType::CAT);
+    for (size_t i = 0; i < cats.size(); ++i) {
+        for (const auto& dir : NEIGHBOURS) {
+            int checkX = cats.x[i] + dir[0];
+            int checkY = cats.y[i] + dir[1];
+            if (level.isTileSolid(checkX, checkY) || entities.isTypeAt(checkX, checkY, EntityType::BLOCK)) {
+                blocked++;
+            }
+        }
+    }
+    return blocked;
+}
+
+// Replace one block with a fresh one on the same tile, the way a trapped cat becomes cheese
+int legacyReplace(Level& level, LegacyLevel& legacy, int n) {
+    const EntityArrays& blocks = level.getEntities().ofType(EntityType::BLOCK);
+    int x = blocks.x[n % blocks.size()];
+    int y = blocks.y[n % blocks.size()];
+    legacy.removeAt(x, y);
+    legacy.add(x, y, EntityType::BLOCK);
+    return static_cast<int>(legacy.objects.size());
+}
+
+int storeReplace(Level& level, LegacyLevel&, int n) {
+    EntityStore& entities = level.getEntities();
+    const EntityArrays& blocks = entities.ofType(EntityType::BLOCK);
+    EntityHandle block = blocks.handle[n % blocks.size()];
+    int x = entities.getX(block);
+    int y = entities.getY(block);
+    entities.destroy(block);
+    entities.create(EntityType::BLOCK, x, y);
+    int total = 0;
+    for (int type = 0; type < ENTITY_TYPE_COUNT; ++type) {
+        total += entities.count(static_cast<EntityType>(type));
+    }
+    return total;
+}
+
+template <typename Work>
+double timeOps(Level& level, LegacyLevel& legacy, int ops, Work work, long long& checksum) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < ops; ++i) {
+        checksum += work(level, legacy, i);
+    }
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / ops;
+}
+
+// Warm up caches and the branch predictor, then alternate to even out noise
+template <typename LegacyWork, typename StoreWork>
+bool compare(const char* name, Level& level, LegacyLevel& legacy, int ops, LegacyWork legacyWork, StoreWork storeWork) {
+    long long legacyChecksum = 0;
+    long long storeChecksum = 0;
+    timeOps(level, legacy, ops / 10 + 1, legacyWork, legacyChecksum);
+    timeOps(level, legacy, ops / 10 + 1, storeWork, storeChecksum);
+    legacyChecksum = storeChecksum = 0;
+
+    double legacyNs = 0.0;
+    double storeNs = 0.0;
+    const int ROUNDS = 5;
+    for (int round = 0; round < ROUNDS; ++round) {
+        legacyNs += timeOps(level, legacy, ops / ROUNDS, legacyWork, legacyChecksum) / ROUNDS;
+        storeNs += timeOps(level, legacy, ops / ROUNDS, storeWork, storeChecksum) / ROUNDS;
+    }
+
+    std::cout << name << std::endl;
+    std::cout << "  unique_ptr vector: " << legacyNs << " ns" << std::endl;
+    std::cout << "  EntityStore:       " << storeNs << " ns (" << (storeNs > 0.0 ? legacyNs / storeNs : 0.0) << "x)" << std::endl;
+    if (legacyChecksum != storeChecksum) {
+        std::cerr << "Checksums differ: " << legacyChecksum << " vs " << storeChecksum << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// Level::updateTrappedCats itself, which only checks cats on or next to changed tiles: once
+// with nothing moving, once with one cat stepping back and forth every frame
+void timeIncrementalCheck(Level& level, int frames) {
+    level.updateTrappedCats(); // The first call after loading checks every cat
+    EntityStore& entities = level.getEntities();
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < frames; ++i) {
+        level.updateTrappedCats();
+    }
+    std::chrono::duration<double, std::nano> stillNs = std::chrono::steady_clock::now() - start;
+
+    EntityHandle mover;
+    int fromX = 0, fromY = 0, toX = 0, toY = 0;
+    const EntityArrays& cats = entities.ofType(EntityType::CAT);
+    for (size_t i = 0; i < cats.size() && !mover.isValid(); ++i) {
+        for (const auto& dir : NEIGHBOURS) {
+            int x = cats.x[i] + dir[0];
+            int y = cats.y[i] + dir[1];
+            if (!level.isTileSolid(x, y) && !entities.isOccupied(x, y)) {
+                mover = cats.handle[i];
+                fromX = cats.x[i];
+                fromY = cats.y[i];
+                toX = x;
+                toY = y;
+                break;
+            }
+        }
+    }
+    if (!mover.isValid()) {
+        return;
+    }
+
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < frames && entities.isAlive(mover); ++i) {
+        if (i % 2 == 0) {
+            entities.setPosition(mover, toX, toY);
+        } else {
+            entities.setPosition(mover, fromX, fromY);
+        }
+        level.updateTrappedCats();
+    }
+    std::chrono::duration<double, std::nano> movingNs = std::chrono::steady_clock::now() - start;
+
+    std::cout << "Level::updateTrappedCats, " << entities.count(EntityType::CAT) << " cats" << std::endl;
+    std::cout << "  nothing moved:  " << stillNs.count() / frames << " ns" << std::endl;
+    std::cout << "  one cat moved:  " << movingNs.count() / frames << " ns" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    int frames = argc > 1 ? std::atoi(argv[1]) : 20000;
+    if (frames <= 0) {
+        std::cerr << "Usage: " << argv[0] << " [frames]" << std::endl;
+        return 1;
+    }
+
+    std::string path = writeBenchLevel();
+    Level level;
+    if (!level.load(path)) {
+        return 1;
+    }
+    std::filesystem::remove(path);
+
+    const EntityStore& entities = level.getEntities();
+    LegacyLevel legacy(level);
+    std::cout << "Level " << level.getWidth() << "x" << level.getHeight() << ": "
+              << legacy.objects.size() << " entities, " << entities.count(EntityType::BLOCK) << " blocks, "
+              << entities.count(EntityType::CAT) << " cats; " << frames << " frames" << std::endl;
+
+    bool ok = compare("Trapped-cat check, per frame", level, legacy, frames,
+                      [](Level& l, LegacyLevel& g, int) { return legacyFrame(l, g); },
+                      [](Level& l, LegacyLevel& g, int) { return storeFrame(l, g); });
+    ok = compare("Remove and re-add one entity", level, legacy, frames, legacyReplace, storeReplace) && ok;
+    timeIncrementalCheck(level, frames);
+    return ok ? 0 : 1;
+}
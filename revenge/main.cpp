@@ -11,7 +11,6 @@
 
 #include "Level.h"
 #include "Player.h"
-#include "Cat.h"
 #include "FontManager.h"
 #include "TextureManager.h"
 
@@ -648,7 +647,7 @@ int main(int argc, char* argv[]) {
                                 break;
                             case MoveResult::BLOCKED_TRAP:
                                 // Remove the trap at the location the player tried to move to
-                                level.removeGameObjectAt(currentPlayer->getX() + dx, currentPlayer->getY() + dy);
+                                level.removeEntitiesAt(currentPlayer->getX() + dx, currentPlayer->getY() + dy);
                                 if (currentPlayer->getLives() <= 0) {
                                     currentState = GameState::GAME_OVER;
                                 } else {
@@ -687,11 +686,7 @@ int main(int argc, char* argv[]) {
             playerLives = currentPlayer->getLives();
 
             // Update all cats
-            for (const auto& obj : level.getGameObjects()) {
-                if (auto* cat = dynamic_cast<Cat*>(obj.get())) {
-                    cat->update(level);
-                }
-            }
+            level.updateCats();
 
             // Check if cats trapped themselves or were trapped by player
             level.updateTrappedCats();